@@ -0,0 +1,201 @@
+/**
+ * @file Bench.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Benchmark settings.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Measures the time of the program operations with warmup and repetitions
+ * and reports each measure as a comma separated line. The peak resident
+ * memory is the one of the whole process up to the measure, so the inputs
+ * are measured from the smallest to the largest.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "Manipulator.hpp"
+
+/**
+ * @class Bench class.
+ * @brief Bench definition with attributes and methods.
+ */
+class Bench {
+public:
+   /**
+    * @brief Construct a new Bench object.
+    *
+    * @param warmup_runs Runs before the measures.
+    * @param measured_runs Measured runs.
+    */
+   Bench(int warmup_runs, int measured_runs) :
+      warmup(warmup_runs),
+      repetitions(measured_runs) { }
+
+   /**
+    * @brief Destroy the Bench object.
+    */
+   ~Bench() { }
+
+   /**
+    * @brief Print the names of the reported columns.
+    */
+   void printHeader() const {
+      std::cout << "operation,input,megapixels,megabytes,median_ms,"
+         << "megapixels_per_s,megabytes_per_s,peak_rss_kb" << std::endl;
+   }
+
+   /**
+    * @brief Measure an operation and print the median of the runs.
+    *
+    * @tparam Setup Callable run before each run, out of the measure.
+    * @tparam Operation Callable measured.
+    * @param operation_name Name of the operation.
+    * @param input_name Name of the input.
+    * @param megapixels Megapixels processed by each run.
+    * @param megabytes Megabytes processed by each run.
+    * @param setup Preparation of each run.
+    * @param operation Operation to measure.
+    */
+   template <typename Setup, typename Operation>
+   void measure(std::string operation_name, std::string input_name,
+      double megapixels, double megabytes, Setup setup, Operation operation)
+   {
+      std::vector<double> times;
+
+      for (int run { 0 }; run < warmup + repetitions; run++) {
+         setup();
+
+         auto start = std::chrono::steady_clock::now();
+         operation();
+         auto finish = std::chrono::steady_clock::now();
+
+         if (run >= warmup) {
+            times.push_back(
+               std::chrono::duration<double, std::milli>(finish - start)
+                  .count()
+            );
+         }
+      }
+
+      std::sort(times.begin(), times.end());
+
+      double median { times[times.size() / 2] };
+
+      if (times.size() % 2 == 0) {
+         median = (median + times[times.size() / 2 - 1]) / 2;
+      }
+
+      double seconds { median / 1000 };
+
+      std::cout << operation_name << "," << input_name << "," << megapixels
+         << "," << megabytes << "," << median << ","
+         << (seconds > 0 ? megapixels / seconds : 0) << ","
+         << (seconds > 0 ? megabytes / seconds : 0) << ","
+         << getPeakMemory() << std::endl;
+   }
+
+   /**
+    * @brief Build an image with reproducible pseudo-random pixels.
+    *
+    * @param type Image type.
+    * @param width Image width.
+    * @param height Image height.
+    * @param colors Maximum of colors per pixel channel.
+    * @return An image.
+    */
+   static Image getSyntheticImage(std::string type, int width, int height,
+      int colors)
+   {
+      Image image { type, width, height, colors };
+      unsigned state { 2463534242u };
+
+      for (int row { 0 }; row < height; row++) {
+         for (int column { 0 }; column < width; column++) {
+            int channels[CHANNELS_PER_PIXEL];
+
+            for (int channel { 0 }; channel < CHANNELS_PER_PIXEL; channel++) {
+               state ^= state << 13;
+               state ^= state >> 17;
+               state ^= state << 5;
+               channels[channel] = (int) (state % (unsigned) (colors + 1));
+            }
+
+            Pixel pixel { channels[0], channels[1], channels[2], colors };
+            image.setPixelUnchecked(pixel, row, column);
+         }
+      }
+
+      return image;
+   }
+
+   /**
+    * @brief Read an ascii image with formatted extraction, pixel by pixel.
+    *
+    * @details Reference for the Reader, as openImage() read the ascii
+    * images before it.
+    *
+    * @param file Input stream.
+    * @param[out] image Image memory position.
+    */
+   static void readFormattedImage(std::istream& file, Image& image) {
+      std::string type { "" };
+      int width { 0 };
+      int height { 0 };
+      int colors { 0 };
+
+      file >> type >> width >> height >> colors;
+
+      image.setType(type);
+      image.setColors(colors);
+      image.setSize(width, height);
+
+      for (int row { 0 }; row < height; row++) {
+         for (int column { 0 }; column < width; column++) {
+            int red { 0 };
+            int green { 0 };
+            int blue { 0 };
+            Pixel pixel;
+            pixel.setColors(colors);
+
+            file >> red >> green >> blue;
+
+            pixel.setRed(red);
+            pixel.setGreen(green);
+            pixel.setBlue(blue);
+
+            image.setPixel(pixel, row, column);
+         }
+      }
+   }
+
+private:
+   int warmup;      /**< Runs before the measures */
+   int repetitions; /**< Measured runs */
+
+   /**
+    * @brief Get the peak resident memory of the process.
+    *
+    * @return Kilobytes.
+    */
+   static long getPeakMemory() {
+      struct rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+
+      return usage.ru_maxrss;
+   }
+};
+
+#endif // BENCH_HPP
@@ -0,0 +1,229 @@
+/**
+ * @file bench.cpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Benchmarks of the program operations.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Measures the startup of the program, the reading of the fonts and every
+ * operation on the original and synthetic images, printing a comma
+ * separated line for each.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#include "Bench.hpp"
+using namespace std;
+
+#define BENCH_INPUT_FILE "bin/bench-input.ppm"   /**< Read by openImage */
+#define BENCH_OUTPUT_FILE "bin/bench-output.ppm" /**< Written by exportImage */
+#define BENCH_PROGRAM "bin/main"                 /**< Run by the startup */
+
+/**
+ * @brief Measure the runs of the program on an image of a single pixel.
+ *
+ * @details The time is the one of the whole process, so it is mostly the
+ * startup of the program. Only the run with a text reads a font.
+ *
+ * @param bench Bench memory position.
+ */
+void benchStartup(Bench& bench) {
+   Editor pixel { Image { BINARY_TYPE, 1, 1, 255 } };
+   exportImage(BENCH_INPUT_FILE, pixel);
+
+   string program { BENCH_PROGRAM " -i " BENCH_INPUT_FILE " -o "
+      BENCH_OUTPUT_FILE };
+
+   pair<string, string> runs[] = {
+      { "-e gray", program + " -e gray" },
+      { "-h +e", BENCH_PROGRAM " -h +e" },
+      { "-t", "echo Benchmark | " + program + " -t" }
+   };
+
+   for (pair<string, string> const& run : runs) {
+      string command { run.second + " > /dev/null" };
+
+      bench.measure("startup", run.first, 1e-6, 0, [] () { }, [&] () {
+         if (system(command.c_str()) != 0) {
+            cerr << "Running error! " << command << endl;
+         }
+      });
+   }
+
+   remove(BENCH_INPUT_FILE);
+   remove(BENCH_OUTPUT_FILE);
+}
+
+/**
+ * @brief Measure every operation of the program on an image.
+ *
+ * @param bench Bench memory position.
+ * @param input_name Name of the input.
+ * @param image Image to process.
+ * @param foreground Foreground image of the combinations.
+ */
+void benchImage(Bench& bench, string input_name, Image const& image,
+   Image const& foreground)
+{
+   double megapixels { image.getSize() / 1e6 };
+   double megabytes { image.getRowSize() * (double) image.getHeight() / 1e6 };
+
+   Editor editor;
+   auto reset = [&] () { editor.setImage(image); };
+
+   bench.measure("grayscaleImage", input_name, megapixels, megabytes, reset,
+      [&] () { editor.grayscaleImage(); });
+   bench.measure("negativeImage", input_name, megapixels, megabytes, reset,
+      [&] () { editor.negativeImage(); });
+   bench.measure("rotateRight", input_name, megapixels, megabytes, reset,
+      [&] () { editor.rotateRight(); });
+   bench.measure("rotateLeft", input_name, megapixels, megabytes, reset,
+      [&] () { editor.rotateLeft(); });
+   bench.measure("invertImage", input_name, megapixels, megabytes, reset,
+      [&] () { editor.invertImage(); });
+   bench.measure("enlargeImage", input_name, megapixels, megabytes, reset,
+      [&] () { editor.enlargeImage(); });
+   bench.measure("reduceImage", input_name, megapixels, megabytes, reset,
+      [&] () { editor.reduceImage(); });
+   bench.measure("reduceImage-8", input_name, megapixels, megabytes, reset,
+      [&] () { editor.reduceImage(8.0); });
+
+   for (string filter : { "nearest", "bilinear", "bicubic" }) {
+      bench.measure("scaleImage-3-" + filter, input_name, megapixels,
+         megabytes, reset, [&] () {
+            editor.scaleImage(3, getFilterByName(filter));
+         });
+   }
+
+   string filters[] = {
+      "sharpening", "blurring", "edge-sharpening", "embossing"
+   };
+
+   for (string const& filter : filters) {
+      bench.measure("applyImageEffects-" + filter, input_name, megapixels,
+         megabytes, reset, [&] () { editor.applyImageEffects(filter); });
+   }
+
+   for (int radius : { 2, 8, 32 }) {
+      bench.measure("blurImage-radius-" + to_string(radius), input_name,
+         megapixels, megabytes, reset, [&] () { editor.blurImage(radius); });
+   }
+
+   bench.measure("combineImages", input_name, megapixels, megabytes, reset,
+      [&] () { editor.combineImages(foreground, 0, 0); });
+   bench.measure("applyBorder", input_name, megapixels, megabytes, reset,
+      [&] () {
+         editor.applyBorder(getColorByName("white"), 25, 50);
+      });
+   bench.measure("writeText", input_name, megapixels, megabytes, reset,
+      [&] () {
+         setText(editor, "Benchmark #RED text :heart: 0123456789", 10, 10,
+            "ibm");
+      });
+
+   Editor exported { image };
+
+   for (string type : { ASCII_TYPE, BINARY_TYPE }) {
+      exported.convertImage(type);
+      exportImage(BENCH_INPUT_FILE, exported);
+
+      ifstream file { BENCH_INPUT_FILE, ios::binary | ios::ate };
+      double file_megabytes { file.tellg() / 1e6 };
+      file.close();
+
+      Image opened;
+
+      bench.measure("openImage-" + type, input_name, megapixels,
+         file_megabytes, [] () { }, [&] () {
+            openImage(BENCH_INPUT_FILE, opened);
+         });
+
+      if (type == ASCII_TYPE) {
+         bench.measure("openImage-P3-formatted", input_name, megapixels,
+            file_megabytes, [] () { }, [&] () {
+               ifstream input { BENCH_INPUT_FILE };
+               Bench::readFormattedImage(input, opened);
+            });
+      }
+
+      bench.measure("exportImage-" + type, input_name, megapixels,
+         file_megabytes, [] () { }, [&] () {
+            exportImage(BENCH_OUTPUT_FILE, exported);
+         });
+   }
+
+   remove(BENCH_INPUT_FILE);
+   remove(BENCH_OUTPUT_FILE);
+}
+
+/**
+ * @brief Measure the operations on synthetic and real images.
+ *
+ * @details The startup of the program and the fonts are measured first.
+ * The real images are the originals of the assets. The arguments
+ * are the sizes of the synthetic images, in megapixels, measured after
+ * them from the smallest to the largest.
+ */
+int main(int argc, char* argv[]) {
+   Bench bench { 1, 5 };
+   bench.printHeader();
+
+   benchStartup(bench);
+
+   /*
+    * The fonts are read only by the runs that write text, so each read is
+    * saved from the startup of the others.
+    */
+   string fonts[] = {
+      "highlander_std", "ib16x16u", "satisfy16", "DSnetChild", "LoveScript",
+      "PixelIconsCompilation"
+   };
+
+   for (string const& font : fonts) {
+      string file { "assets/fonts/" + font + ".bdf" };
+
+      ifstream bdf { file, ios::binary | ios::ate };
+      double megabytes { bdf.tellg() / 1e6 };
+      bdf.close();
+
+      bench.measure("readBDF", font, 0, megabytes, [] () { }, [&] () {
+         Font read { file };
+      });
+   }
+
+   Image foreground;
+   openImage("assets/imgs/bill_cropped.ppm", foreground);
+
+   string assets[] = {
+      "bill", "bill_cropped", "chambers", "flowers", "galinhos", "headlight",
+      "mule", "mule_cropped"
+   };
+
+   for (string const& asset : assets) {
+      Image image;
+      openImage("assets/imgs/" + asset + ".ppm", image);
+
+      benchImage(bench, asset, image, foreground);
+   }
+
+   for (int index { 1 }; index < argc; index++) {
+      double megapixels { atof(argv[index]) };
+
+      if (megapixels <= 0) {
+         continue;
+      }
+
+      /*
+       * Synthetic images keep the 4:3 aspect ratio of most photos.
+       */
+      int width { (int) round(sqrt(megapixels * 1e6 * 4 / 3)) };
+      int height { (int) round(megapixels * 1e6 / width) };
+
+      Image synthetic {
+         Bench::getSyntheticImage(BINARY_TYPE, width, height, 255)
+      };
+
+      benchImage(bench, "synthetic-" + string(argv[index]) + "MP", synthetic,
+         foreground);
+   }
+}
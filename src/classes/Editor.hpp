@@ -13,14 +13,25 @@
 #ifndef EDITOR_HPP
 #define EDITOR_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <stdint.h>
 #include <string.h>
+#include <utility>
 #include <vector>
 #include "Image.hpp"
 #include "Pair.hpp"
 #include "Enums.hpp"
+#include "Kernels.hpp"
+#include "Convolution.hpp"
+#include "Resampling.hpp"
+#include "ThreadPool.hpp"
 
-#define MASK_SIZE 3 /**< Mask width and height */
+#define MIN_BAND_ROWS 16 /**< Fewest rows of the bands run by each thread */
+#define ROTATE_TILE 32   /**< Pixels of the side of the rotation tiles */
 
 /**
  * @class Editor class.
@@ -40,10 +51,11 @@ public:
     * @param width Image width.
     * @param height Image height.
     * @param colors Maximum of colors per pixel channel.
-    * @param pixels Image pixels.
+    * @param pixels Image pixels, row after row, without padding.
     * @see setImage()
     */
-   Editor(std::string type, int width, int height, int colors, Pixel** pixels)
+   Editor(std::string type, int width, int height, int colors, 
+      Pixel const* pixels)
    {
       setImage(type, width, height, colors, pixels);
    }
@@ -56,6 +68,14 @@ public:
     */
    Editor(Image const& image) { setImage(image); }
 
+   /**
+    * @brief Construct a new Editor object taking an image (move).
+    *
+    * @param image An image to move into the editor.
+    * @see setImage()
+    */
+   Editor(Image&& image) { setImage(std::move(image)); }
+
    /**
     * @brief Construct a new Editor object with another editor (copy).
     *
@@ -67,19 +87,57 @@ public:
       setImage(rhs.getImage());
       setBorderSize(rhs.getBorderSize());
       setExtraBorderSize(rhs.getExtraBorderSize());
+      setThreads(rhs.getThreads());
+   }
+
+   /**
+    * @brief Construct a new Editor object with another editor (move).
+    *
+    * @param rhs A editor to move.
+    * @see setImage()
+    * @see releaseImage()
+    */
+   Editor(Editor&& rhs) {
+      setImage(rhs.releaseImage());
+      setBorderSize(rhs.getBorderSize());
+      setExtraBorderSize(rhs.getExtraBorderSize());
+      setThreads(rhs.getThreads());
    }
 
    /**
     * @brief Operator to receive a editor (copy).
     *
     * @param rhs A editor to receive.
+    * @return This editor.
     * @see setImage()
     * @see getImage()
     */
-   void operator=(Editor const& rhs) {
+   Editor& operator=(Editor const& rhs) {
       setImage(rhs.getImage());
       setBorderSize(rhs.getBorderSize());
       setExtraBorderSize(rhs.getExtraBorderSize());
+      setThreads(rhs.getThreads());
+
+      return *this;
+   }
+
+   /**
+    * @brief Operator to receive a editor (move).
+    *
+    * @param rhs A editor to move.
+    * @return This editor.
+    * @see setImage()
+    * @see releaseImage()
+    */
+   Editor& operator=(Editor&& rhs) {
+      if (this != &rhs) {
+         setImage(rhs.releaseImage());
+         setBorderSize(rhs.getBorderSize());
+         setExtraBorderSize(rhs.getExtraBorderSize());
+         setThreads(rhs.getThreads());
+      }
+
+      return *this;
    }
 
    /**
@@ -94,10 +152,10 @@ public:
     * @param width Image width.
     * @param height Image height.
     * @param colors Maximum of colors per pixel channel.
-    * @param pixels Image pixels.
+    * @param pixels Image pixels, row after row, without padding.
     */
    void setImage(std::string type, int width, int height, int colors, 
-      Pixel** pixels) 
+      Pixel const* pixels) 
    {
       image = Image{ type, width, height, colors, pixels };
    }
@@ -105,19 +163,38 @@ public:
    /**
     * @brief Set image with other image.
     * 
-    * @param image An image.
+    * @param copy_image An image.
     */
    void setImage(Image const& copy_image) 
    {
       image = copy_image;
    }
 
+   /**
+    * @brief Set image taking other image, without copying its pixels.
+    * 
+    * @param new_image An image to move into the editor.
+    */
+   void setImage(Image&& new_image) 
+   {
+      image = std::move(new_image);
+   }
+
    /**
     * @brief Get image.
     *
-    * @return An image with the last modification.
+    * @return The image with the last modification (read only).
     */
-   Image getImage() const { return image; }
+   Image const& getImage() const { return image; }
+
+   /**
+    * @brief Take the image out of the editor, without copying its pixels.
+    *
+    * @details The editor is left without an image until a new one is set.
+    *
+    * @return The image with the last modification.
+    */
+   Image releaseImage() { return std::move(image); }
 
    /**
     * @brief Get the image width.
@@ -155,140 +232,243 @@ public:
    int getExtraBorderSize() const { return extra_border_size; }
 
    /**
-    * @brief Transform the image into grayscale.
+    * @brief Set the threads of the effects that run in parallel.
+    *
+    * @details The results do not depend on the threads, only the time.
+    *
+    * @param number Threads, counting the caller. Values below 1 are taken
+    * as 1.
     */
-   void grayscaleImage() {
-      int width { image.getWidth() };
-      int height { image.getHeight() };
-      int colors { image.getColors() };
+   void setThreads(int number) {
+      threads = std::max(number, 1);
+   }
 
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            Pixel pixel = image.getPixel(row, column);
+   /**
+    * @brief Get the threads of the effects that run in parallel.
+    *
+    * @return An integer. Default is ThreadPool::getDefaultThreads().
+    */
+   int getThreads() const { return threads; }
 
-            /*
-             * Calculate the average of the channels in the pixel.
-             */
-            int average { (pixel.getRed() + pixel.getGreen()
-               + pixel.getBlue()) / CHANNELS_PER_PIXEL };
+   /**
+    * @brief Split the rows of the image in bands and run them in parallel.
+    *
+    * @details Each band has at least #MIN_BAND_ROWS rows and at most one
+    * band goes to each thread. The pool is created on the first use and
+    * again when the threads change, and it is also used to export the
+    * image.
+    *
+    * @param rows Rows to split.
+    * @param band Function called with the first row of a band and the row
+    * after its last.
+    */
+   void forEachBand(int rows, std::function<void(int, int)> const& band) {
+      int bands { std::min(threads, rows / MIN_BAND_ROWS) };
 
-            Pixel grayscale_pixel { average, average, average, colors };
-            image.setPixel(grayscale_pixel, row, column);
-         }
+      if (bands < 2) {
+         band(0, rows);
+         return;
+      }
+
+      if (!pool || pool->getThreads() != threads) {
+         pool.reset(new ThreadPool { threads });
+      }
+
+      pool->run(bands, [&] (int index) {
+         band((int) ((int64_t) rows * index / bands),
+            (int) ((int64_t) rows * (index + 1) / bands));
+      });
+   }
+
+   /**
+    * @brief Transform the image into grayscale.
+    * @see grayscaleRows()
+    */
+   void grayscaleImage() {
+      if (image.isWide()) {
+         grayscaleRows<RGB16>();
+      } else {
+         grayscaleRows<RGB8>();
       }
    }
 
    /**
     * @brief Transform the image into negative.
+    * @see negativeRows()
     */
    void negativeImage() {
-      int width { image.getWidth() };
-      int height {image.getHeight() };
-      int colors { image.getColors() };
+      if (image.isWide()) {
+         negativeRows<RGB16>();
+      } else {
+         negativeRows<RGB8>();
+      }
+   }
 
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            Pixel pixel { image.getPixel(row, column) };
+   /**
+    * @brief Apply a chain of point-wise effects in a single pass.
+    *
+    * @details After a grayscale every pixel is gray, so a later grayscale
+    * changes nothing and the negatives after it only flip one another. Any
+    * chain is then a negative or not, a grayscale or not and a negative or
+    * not, run by one kernel over the pixels. The result is the same of
+    * applying the effects one after the other.
+    *
+    * @param effects Effects in the order to apply. Accepts #Gray and
+    * #Negative, the others are ignored.
+    * @see grayscaleRows()
+    * @see negativeRows()
+    */
+   void applyPointEffects(std::vector<Effects> const& effects) {
+      bool gray { false };
+      bool before { false };
+      bool after { false };
+
+      for (Effects effect : effects) {
+         if (effect == Gray) {
+            gray = true;
+         } else if (effect == Negative && gray) {
+            after = !after;
+         } else if (effect == Negative) {
+            before = !before;
+         }
+      }
 
-            /*
-             * It subtracts the maximum number of colors per channel by the
-             * value of each one.
-             */
-            int new_red { colors - pixel.getRed() };
-            int new_green { colors - pixel.getGreen() };
-            int new_blue { colors - pixel.getBlue() };
+      if (gray && image.isWide()) {
+         grayscaleRows<RGB16>(before, after);
+      } else if (gray) {
+         grayscaleRows<RGB8>(before, after);
+      } else if (before) {
+         negativeImage();
+      }
+   }
 
-            Pixel negative_pixel { new_red, new_green, new_blue, colors };
-            image.setPixel(negative_pixel, row, column);
+   /**
+    * @brief Apply a chain of rotations and mirrors in a single pass.
+    *
+    * @details The chain is folded into one of the 8 symmetries of the
+    * rectangle, kept as a transpose or not followed by the mirrors of the
+    * rows and of the columns. The identity leaves the image untouched and
+    * the others move each pixel once.
+    *
+    * @param effects Effects in the order to apply. Accepts #Rotate_Right,
+    * #Rotate_Left, #Rotate_Half, #Invert and #Flip, the others are
+    * ignored.
+    * @see transposeRows()
+    */
+   void applyGeometricEffects(std::vector<Effects> const& effects) {
+      bool transpose { false };
+      bool mirror_rows { false };
+      bool mirror_columns { false };
+
+      for (Effects effect : effects) {
+         bool rows { mirror_rows };
+         bool columns { mirror_columns };
+
+         /*
+          * A transpose after a mirror is the other mirror after the
+          * transpose. The right turn is a transpose and a mirror of the
+          * columns and the left turn a transpose and a mirror of the rows.
+          */
+         if (effect == Rotate_Right) {
+            transpose = !transpose;
+            mirror_rows = columns;
+            mirror_columns = !rows;
+         } else if (effect == Rotate_Left) {
+            transpose = !transpose;
+            mirror_rows = !columns;
+            mirror_columns = rows;
+         } else if (effect == Rotate_Half) {
+            mirror_rows = !rows;
+            mirror_columns = !columns;
+         } else if (effect == Invert) {
+            mirror_columns = !columns;
+         } else if (effect == Flip) {
+            mirror_rows = !rows;
          }
       }
+
+      if (transpose && image.isWide()) {
+         transposeRows<RGB16>(mirror_rows, mirror_columns);
+      } else if (transpose) {
+         transposeRows<RGB8>(mirror_rows, mirror_columns);
+      } else if (mirror_rows && mirror_columns) {
+         rotateHalf();
+      } else if (mirror_rows) {
+         flipImage();
+      } else if (mirror_columns) {
+         invertImage();
+      }
    }
 
    /**
     * @brief Rotate image to the right.
-    * @see setImage()
+    * @see rotateRightRows()
     */
    void rotateRight() {
-      int width { image.getWidth() };
-      int height { image.getHeight() };
-
-      Image rotate { image.getType(), height, width, image.getColors() };
-
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            /*
-             * Sets the pixel of the rotation image with the pixel of the
-             * buffer image, in the defined row and column, to the position
-             * determined by (column, height - row + 1).
-             * Relationship obtained from the observations.
-             */
-            rotate.setPixel(image.getPixel(row, column), column, 
-               height - row - 1);
-         }
+      if (image.isWide()) {
+         rotateRightRows<RGB16>();
+      } else {
+         rotateRightRows<RGB8>();
       }
-
-      setImage(rotate);
    }
 
    /**
     * @brief Rotate image to the left.
-    * @see setImage()
+    * @see rotateLeftRows()
     */
    void rotateLeft() {
-      int width { image.getWidth() };
-      int height { image.getHeight() };
-
-      Image rotate { image.getType(), height, width, image.getColors() };
-
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            /*
-             * Sets the pixel of the rotation image with the pixel of the
-             * buffer image, in the defined row and column, to the position
-             * determined by (width - column + 1, row).
-             * Relationship obtained from the observations.
-             */
-            rotate.setPixel(
-               image.getPixel(row, column), 
-               width - column - 1, 
-               row
-            );
-         }
+      if (image.isWide()) {
+         rotateLeftRows<RGB16>();
+      } else {
+         rotateLeftRows<RGB8>();
       }
-
-      setImage(rotate);
    }
 
    /**
     * @brief Invert the image.
-    * @see setImage()
+    * @see invertRows()
     */
    void invertImage() {
-      int width { image.getWidth() };
-      int height { image.getHeight() };
-
-      Image invert { image.getType(), width, height, image.getColors() };
+      if (image.isWide()) {
+         invertRows<RGB16>();
+      } else {
+         invertRows<RGB8>();
+      }
+   }
 
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            /*
-             * Get the invert pixel of the buffer image.
-             */
-            Pixel pixel { image.getPixel(row, width - column - 1) };
-            invert.setPixel(pixel, row, column);
-         }
+   /**
+    * @brief Rotate the image by 180 degrees.
+    * @see rotateHalfRows()
+    */
+   void rotateHalf() {
+      if (image.isWide()) {
+         rotateHalfRows<RGB16>();
+      } else {
+         rotateHalfRows<RGB8>();
       }
+   }
 
-      setImage(invert);
+   /**
+    * @brief Flip the image upside down.
+    * @see flipRows()
+    */
+   void flipImage() {
+      if (image.isWide()) {
+         flipRows<RGB16>();
+      } else {
+         flipRows<RGB8>();
+      }
    }
 
    /**
     * @brief Rotate the image.
     * 
-    * @param side Side of rotation. Accepts "right", "left" and "invert".
-    * Default is "right".
+    * @param side Side of rotation. Accepts "right", "left", "half",
+    * "invert" and "flip". Default is "right".
     * @see rotateRight()
     * @see rotateLeft()
+    * @see rotateHalf()
+    * @see invertImage()
     * @see flipImage()
     */
    void rotateImage(std::string side = "right") {
@@ -296,187 +476,245 @@ public:
          rotateRight();
       } else if (side == "left") {
          rotateLeft();
+      } else if (side == "half") {
+         rotateHalf();
       } else if (side == "invert") {
          invertImage();
+      } else if (side == "flip") {
+         flipImage();
       }
    }
 
    /**
-    * @brief Enlarge image.
-    * @see getAveragePixelIntensity()
-    * @see setImage()
+    * @brief Resize the image.
+    *
+    * @param width Width of the resized image.
+    * @param height Height of the resized image.
+    * @param filter Resampling filter, #Nearest, #Bilinear or #Bicubic.
+    * Default is #Bilinear. Other filters, sizes below 1 and sizes above
+    * #MAX_WIDTH by #MAX_HEIGHT leave the image unchanged.
+    * @param truncate Whether the sums are truncated instead of rounded,
+    * as in enlargeImage(). Default is false.
+    * @see resizeRows()
     */
-   void enlargeImage() {
-      int width { 2 * image.getWidth() - 1 };
-      int height { 2 * image.getHeight() - 1 };
+   void resizeImage(int width, int height, Filters filter = Bilinear,
+      bool truncate = false)
+   {
+      if (width < 1 || height < 1 || width > MAX_WIDTH ||
+         height > MAX_HEIGHT || filter == Filter_None)
+      {
+         return;
+      }
 
-      Image enlarge { image.getType(), width, height, image.getColors() };
+      if (image.isWide()) {
+         resizeRows<RGB16>(width, height, filter, truncate);
+      } else {
+         resizeRows<RGB8>(width, height, filter, truncate);
+      }
+   }
+
+   /**
+    * @brief Scale the image by a factor.
+    *
+    * @details The image is resized to (width - 1) * factor + 1 by
+    * (height - 1) * factor + 1 pixels, so the original pixels keep their
+    * places for the whole factors.
+    *
+    * @param factor Factor of the scale, above 0. Factors whose sizes are
+    * above #MAX_WIDTH by #MAX_HEIGHT leave the image unchanged.
+    * @param filter Resampling filter. Default is #Bilinear.
+    * @see resizeImage()
+    */
+   void scaleImage(double factor, Filters filter = Bilinear) {
+      double width { std::floor((image.getWidth() - 1) * factor + 0.5) + 1 };
+      double height { std::floor((image.getHeight() - 1) * factor + 0.5)
+         + 1 };
 
       /*
-       * Fills in the original pixels, the pixels immediately below and the 
-       * pixels immediately to the sides of the original
+       * The sizes are checked before they are cast to integers, which is
+       * not defined for the sizes of huge factors.
        */
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            Pixel enlarge_pixel;
-
-            if (row % 2 == 0 && column % 2 == 0) {
-               enlarge_pixel = image.getPixel(row / 2, column / 2);
-            } else if (row % 2 == 0) {
-               Pixel pixels_auxiliary[2] = {
-                  image.getPixel(row / 2, (column - 1) / 2),
-                  image.getPixel(row / 2, (column + 1) / 2)
-               };
-               enlarge_pixel = getAveragePixelIntensity(pixels_auxiliary, 2);
-            } else if (column % 2 == 0) {
-               Pixel pixels_auxiliary[2] = {
-                  image.getPixel((row - 1) / 2, column / 2),
-                  image.getPixel((row + 1) / 2, column / 2)
-               };
-               enlarge_pixel = getAveragePixelIntensity(pixels_auxiliary, 2);
-            }
+      if (!(factor > 0) || width > MAX_WIDTH || height > MAX_HEIGHT) {
+         return;
+      }
 
-            enlarge.setPixel(enlarge_pixel, row, column);
-         }
+      resizeImage((int) width, (int) height, filter);
+   }
+
+   /**
+    * @brief Enlarge image.
+    *
+    * @details Puts the averages of the neighbors between the pixels, the
+    * same as scaling by 2 with the bilinear filter, but truncated like the
+    * other effects of the editor.
+    * @see resizeImage()
+    */
+   void enlargeImage() {
+      resizeImage(2 * image.getWidth() - 1, 2 * image.getHeight() - 1,
+         Bilinear, true);
+   }
+
+   /**
+    * @brief Reduce the image to a size.
+    *
+    * @details Each pixel is the average of the box of the image it covers,
+    * the pixels on the edges of the box weighted by their part in it.
+    *
+    * @param width Width of the reduced image, from 1 to the width of the
+    * image.
+    * @param height Height of the reduced image, from 1 to the height of
+    * the image.
+    * @see reduceRows()
+    */
+   void reduceImage(int width, int height) {
+      if (width < 1 || height < 1 || width > image.getWidth() ||
+         height > image.getHeight())
+      {
+         return;
       }
-      
-      /*
-       * Fills in the pixels on the diagonals of the original pixels based on
-       * the pixels below and above them generated in the previous loop.
-       */
-      for (int row { 1 }; row < height; row += 2) {
-         for (int column { 1 }; column < width; column += 2) {
-            Pixel enlarge_pixel;
 
-            Pixel pixels_auxiliary[2] = {
-               enlarge.getPixel(row - 1, column),
-               enlarge.getPixel(row + 1, column)
-            };
-            enlarge_pixel = getAveragePixelIntensity(pixels_auxiliary, 2);
+      reduceAreas(getAreasBySize(image.getWidth(), width),
+         getAreasBySize(image.getHeight(), height));
+   }
 
-            enlarge.setPixel(enlarge_pixel, row, column);
-         }
+   /**
+    * @brief Reduce the image by a factor.
+    *
+    * @details Each pixel is the average of a box of factor by factor
+    * pixels of the image and the pixels after the last whole box are left
+    * out.
+    *
+    * @param factor Factor of the reduction, from 1 to the sides of the
+    * image.
+    * @see reduceRows()
+    */
+   void reduceImage(double factor) {
+      if (!(factor >= 1) || factor > image.getWidth() ||
+         factor > image.getHeight())
+      {
+         return;
       }
 
-      setImage(enlarge);
+      reduceAreas(getAreasByFactor(image.getWidth(), factor),
+         getAreasByFactor(image.getHeight(), factor));
    }
 
    /**
     * @brief Reduce image.
-    * @see getAveragePixelIntensity()
-    * @see setImage()
+    *
+    * @details Averages each block of 2 by 2 pixels, dropping the last odd
+    * row and column.
+    * @see reduceImage(double)
     */
    void reduceImage() {
-      int width { image.getWidth() % 2 == 0 ? image.getWidth() / 2
-         : (image.getWidth() - 1) / 2 };
-      int height { image.getHeight() % 2 == 0 ? image.getHeight() / 2
-         : (image.getHeight() - 1) / 2 };
-
-      Image reduce { image.getType(), width, height, image.getColors() };
-
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            /*
-             * Calculate the average of the pixel and the three adjacent 
-             * pixels.
-             */
-            int quant_pixels { 4 };
-            Pixel pixels[quant_pixels] = { 
-               image.getPixel(row * 2, column * 2),
-               image.getPixel(row * 2, column * 2 + 1),
-               image.getPixel(row * 2 + 1, column * 2),
-               image.getPixel(row * 2 + 1, column * 2 + 1) 
-            };
+      reduceImage(2.0);
+   }
 
-            Pixel pixel_average { 
-               getAveragePixelIntensity(pixels, quant_pixels) 
-            };
+   /**
+    * @brief Reduce the image by averaging the areas of its pixels.
+    *
+    * @details The image may be a band of a larger image, as in a Streamer,
+    * reduced with the areas of its rows taken by getAreasSlice().
+    *
+    * @param columns Areas of the columns.
+    * @param rows Areas of the rows.
+    * @see reduceRows()
+    */
+   void reduceAreas(Areas const& columns, Areas const& rows) {
+      /*
+       * Smaller accumulators are faster, when the largest sum fits them.
+       */
+      bool narrow { (uint64_t) image.getColors() * columns.total
+         * rows.total <= UINT32_MAX };
 
-            reduce.setPixel(pixel_average, row, column);
+      if (image.isWide()) {
+         if (narrow) {
+            reduceRows<RGB16, uint32_t>(columns, rows);
+         } else {
+            reduceRows<RGB16, uint64_t>(columns, rows);
+         }
+      } else {
+         if (narrow) {
+            reduceRows<RGB8, uint32_t>(columns, rows);
+         } else {
+            reduceRows<RGB8, uint64_t>(columns, rows);
          }
       }
-
-      setImage(reduce);
    }
 
    /**
     * @brief Apply different filters to the image.
     * 
     * @param filter Filter to be apply. Accepts "sharpening", "blurring",
-    * "edge-sharpening" and "embossing". Default is "sharpening".
-    * @see putOnMask()
+    * "edge-sharpening" and "embossing". Default is "sharpening". Other
+    * filters leave the image unchanged.
+    * @see convolve()
     */
    void applyImageEffects(std::string filter = "sharpening") {
-      float mask[MASK_SIZE][MASK_SIZE];
-
       if (filter == "sharpening") {
-         float buff_mask[MASK_SIZE][MASK_SIZE] = { 
-            { 0, -1,  0 }, 
-            { -1, 5, -1 }, 
-            { 0, -1,  0 } 
-         };
-
-         memcpy(mask, buff_mask, sizeof(mask));
+         convolve<SharpeningMask>();
       } else if (filter == "blurring") {
-         float buff_mask[MASK_SIZE][MASK_SIZE] = { 
-            { 1.0 / 9, 1.0 / 9, 1.0 / 9 }, 
-            { 1.0 / 9, 1.0 / 9, 1.0 / 9 },
-            { 1.0 / 9, 1.0 / 9, 1.0 / 9 } 
-         };
-
-         memcpy(mask, buff_mask, sizeof(mask));
+         convolve<BlurringMask>();
       } else if (filter == "edge-sharpening") {
-         float buff_mask[MASK_SIZE][MASK_SIZE] = { 
-            { -1, -1, -1 },
-            { -1,  9, -1 },
-            { -1, -1, -1 } 
-         };
-
-         memcpy(mask, buff_mask, sizeof(mask));
+         convolve<EdgeSharpeningMask>();
       } else if (filter == "embossing") {
-         float buff_mask[MASK_SIZE][MASK_SIZE] = { 
-            { -2, -1, 0 }, 
-            { -1,  1, 1 }, 
-            {  0,  1, 2 } 
-         };
-
-         memcpy(mask, buff_mask, sizeof(mask));
+         convolve<EmbossingMask>();
       }
+   }
 
-      putOnMask(mask);
+   /**
+    * @brief Blur the image with the mean of a square around each pixel.
+    *
+    * @details The square has 2 * radius + 1 pixels of side, taken from the
+    * nearest edge outside the image. A radius of 1 is the blurring mask of
+    * applyImageEffects() and larger radius use running sums, so each pixel
+    * costs the same whatever the radius. A radius below 1 leaves the image
+    * unchanged.
+    *
+    * @param radius Pixels from the center to the side of the square.
+    * @see applyImageEffects()
+    * @see blurRows()
+    */
+   void blurImage(int radius = 1) {
+      if (radius == 1) {
+         applyImageEffects("blurring");
+      } else if (radius > 1 && image.isWide()) {
+         blurRows<RGB16>(radius);
+      } else if (radius > 1) {
+         blurRows<RGB8>(radius);
+      }
    }
 
    /**
     * @brief Combine an image with a foreground image of equal size.
     * 
+    * @details Foregrounds inside the image are copied row by row, after
+    * their colors are rescaled to those of the image in a single pass. The
+    * others go through the clamping accessors, which keep the foreground on
+    * the image.
+    * 
     * @param foreground foreground image.
     * @param x Displacement in X axis.
     * @param y Displacement in Y axis
-    * @see getWidth()
-    * @see getHeight()
+    * @see combineFormats()
+    * @see Image::rescaleColors()
     */
    void combineImages(Image const& foreground, int x, int y) {
-      int back_width { getWidth() };
-      int back_height { getHeight() };
-      int fore_width { foreground.getWidth() };
-      int fore_height { foreground.getHeight() };
-
-      Pixel first_pixel { foreground.getPixel(0, 0) }; /* Pixel to ignore */
-
-      for (int back_row { y }, fore_row { 0 }; 
-         back_row < back_height && fore_row < fore_height; 
-         back_row++, fore_row++) 
-      {
-         for (int back_column { x }, fore_column { 0 }; 
-            back_column < back_width && fore_column < fore_width; 
-            back_column++, fore_column++) 
-         {
-            Pixel pixel { foreground.getPixel(fore_row, fore_column) };
-
-            if (pixel != first_pixel) {
-               image.setPixel(pixel, back_row, back_column);
-            }
+      if (x < 0 || y < 0) {
+         combinePixels(foreground, x, y);
+      } else if (foreground.getColors() != getColors()) {
+         Image rescaled { foreground };
+         rescaled.rescaleColors(getColors());
+
+         if (foreground.isWide()) {
+            combineFormats<RGB16>(rescaled, foreground, x, y);
+         } else {
+            combineFormats<RGB8>(rescaled, foreground, x, y);
          }
+      } else if (foreground.isWide()) {
+         combineFormats<RGB16>(foreground, foreground, x, y);
+      } else {
+         combineFormats<RGB8>(foreground, foreground, x, y);
       }
    }
 
@@ -486,40 +724,21 @@ public:
     * @param pixel An Pixel on the border. 
     * @param size Border size.
     * @param additional_size Additional size for the bottom border.
-    * @see getWidth()
-    * @see getHeight()
-    * @see getColors()
-    * @see setImage()
+    * @see borderRows()
     */
    void applyBorder(Pixel pixel, int size, int additional_size) {
-      int width { getWidth() };
-      int height { getHeight() };
-      int colors { getColors() };
-
-      width += 2 * size;
-      height += 2 * size + additional_size;
-
-      Image border { image.getType(), width, height, colors };
+      if (pixel.getMaxColors() != getColors()) {
+         pixel.setColors(getColors());
+      }
 
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            if ((row >= size && row < height - (size + additional_size)) &&
-               (column >= size && column < width - size))
-            {
-               border.setPixel(
-                  image.getPixel(row - size, column - size), 
-                  row, 
-                  column
-               );
-            } else {
-               border.setPixel(pixel, row, column);
-            }
-         }
+      if (image.isWide()) {
+         borderRows<RGB16>(pixel, size, additional_size);
+      } else {
+         borderRows<RGB8>(pixel, size, additional_size);
       }
 
       setBorderSize(size);
       setExtraBorderSize(additional_size);
-      setImage(border);
    }
 
    /**
@@ -530,14 +749,14 @@ public:
     * @param y Displacement in Y axis
     * @param font Font memory position.
     */
-   void writeText(std::vector<Pair<TypeText, std::string>> mapped_text,
+   void writeText(std::vector<Pair<TypeText, std::string>> const& mapped_text,
       int x, int y, Font const& font)
    {  
       Pixel color { getColorByCode("#BLACK") };
       color.setColors(getColors());
       y += 24; /* Adds the size of the line */
 
-      for (auto pair : mapped_text) {
+      for (auto const& pair : mapped_text) {
          if (pair.getDescription() == Color) {
             color = getColorByCode(pair.getValue());
             color.setColors(getColors());
@@ -583,6 +802,8 @@ private:
    Image image;                  /**< Image */
    int border_size { 0 };        /**< Border size */
    int extra_border_size { 0 };  /**< Extra border size */
+   int threads { ThreadPool::getDefaultThreads() }; /**< Threads of effects */
+   std::unique_ptr<ThreadPool> pool; /**< Pool of the threads, when used */
 
    /**
     * @brief Set the border size.
@@ -603,122 +824,721 @@ private:
    }
 
    /**
-    * @public
-    * @brief Get the average pixel among several pixels.
-    * 
-    * @param pixels Multiple pixels.
-    * @param size Number of pixels.
-    * @return A pixel.
+    * @brief Put a mask on the whole image.
+    *
+    * @tparam Mask Mask of the effect, see Convolution.hpp.
+    * @see convolveRows()
     */
-   Pixel getAveragePixelIntensity(Pixel* pixels, int size) {
-      int colors { pixels[0].getMaxColors() };
+   template <typename Mask>
+   void convolve() {
+      if (image.isWide()) {
+         convolveRows<Mask, RGB16>();
+      } else {
+         convolveRows<Mask, RGB8>();
+      }
+   }
 
-      int red_sum { 0 };
-      int green_sum { 0 };
-      int blue_sum { 0 };
+   /**
+    * @brief Copy the channels of a pixel.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param source First channel of the pixel to copy.
+    * @param destination First channel of the copy.
+    */
+   template <typename Channel>
+   static void copyPixel(Channel const* source, Channel* destination) {
+      destination[0] = source[0];
+      destination[1] = source[1];
+      destination[2] = source[2];
+   }
 
-      for (int index { 0 }; index < size; index++) {
-         red_sum += pixels[index].getRed();
-         green_sum += pixels[index].getGreen();
-         blue_sum += pixels[index].getBlue();
+   /**
+    * @brief Transform the rows of the image into grayscale.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @param before Transform the rows into negative before.
+    * @param after Transform the rows into negative after.
+    * @see grayscaleChannels()
+    */
+   template <typename Format>
+   void grayscaleRows(bool before = false, bool after = false) {
+      size_t channels { (size_t) image.getWidth() * CHANNELS_PER_PIXEL };
+
+      for (int row { 0 }; row < image.getHeight(); row++) {
+         grayscaleChannels(image.getRow<Format>(row), channels,
+            image.getColors(), before, after);
       }
+   }
 
-      /*
-       * Divide the sums of the channels of the various pixels by the number of
-       * pixels.
-       */
-      int red_average { red_sum / size };
-      int green_average { green_sum / size };
-      int blue_average { blue_sum / size };
+   /**
+    * @brief Transform the rows of the image into negative.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see negativeChannels()
+    */
+   template <typename Format>
+   void negativeRows() {
+      size_t channels { (size_t) image.getWidth() * CHANNELS_PER_PIXEL };
+
+      for (int row { 0 }; row < image.getHeight(); row++) {
+         negativeChannels(image.getRow<Format>(row), channels,
+            image.getColors());
+      }
+   }
 
-      Pixel pixel_average { red_average, green_average, blue_average, colors };
+   /**
+    * @brief Copy the pixels of a row in the reverse order.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param source First channel of the row to copy.
+    * @param width Pixels of the row.
+    * @param destination First channel of the reversed row.
+    */
+   template <typename Channel>
+   static void reverseRow(Channel const* source, int width,
+      Channel* destination)
+   {
+      Channel const* pixel { source + width * CHANNELS_PER_PIXEL };
 
-      return pixel_average;
+      for (int column { 0 }; column < width; column++) {
+         pixel -= CHANNELS_PER_PIXEL;
+         copyPixel(pixel, destination + column * CHANNELS_PER_PIXEL);
+      }
    }
 
    /**
-    * @public
-    * @brief Put a defined filter on a pixel.
-    * 
-    * @param pixels Pixels for Analysis. The center is the filter pixel.
-    * @param mask Filter mask with the size defined by #MASK_SIZE x #MASK_SIZE.
-    * @return A pixel. 
+    * @brief Transpose the rows of the image, mirrored or not.
+    *
+    * @details The image is walked in square tiles of #ROTATE_TILE pixels
+    * of side. The rows of a tile stay in the cache while each of its
+    * columns is written as a run of contiguous pixels of the result,
+    * instead of writing every pixel in a different row. The quarter turns
+    * are transposes with one of the mirrors.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @param mirror_rows Mirror the rows of the transpose upside down.
+    * @param mirror_columns Mirror the columns of the transpose.
+    * @see setImage()
     */
-   Pixel putFilterOnPixel(Pixel pixels[MASK_SIZE][MASK_SIZE],
-      float mask[MASK_SIZE][MASK_SIZE]) {
-      int colors { pixels[0][0].getMaxColors() };
+   template <typename Format>
+   void transposeRows(bool mirror_rows, bool mirror_columns) {
+      typedef typename Format::Channel Channel;
 
-      float sum_red { 0 };
-      float sum_green { 0 };
-      float sum_blue { 0 };
+      int width { image.getWidth() };
+      int height { image.getHeight() };
+      int step { mirror_columns ? -CHANNELS_PER_PIXEL : CHANNELS_PER_PIXEL };
 
-      for (int row { 0 }; row < MASK_SIZE; row++) {
-         for (int column { 0 }; column < MASK_SIZE; column++) {
-            /*
-             * Sums the pixel channels multiplied by their weight in the mask.
-             */
-            sum_red += pixels[row][column].getRed() * mask[row][column];
-            sum_green += pixels[row][column].getGreen() * mask[row][column];
-            sum_blue += pixels[row][column].getBlue() * mask[row][column];
+      Image transpose { image.getType(), height, width, image.getColors() };
+
+      for (int first_row { 0 }; first_row < height; first_row += ROTATE_TILE) {
+         int rows { std::min(ROTATE_TILE, height - first_row) };
+         int start { mirror_columns ? height - first_row - 1 : first_row };
+         Channel const* sources[ROTATE_TILE];
+
+         for (int row { 0 }; row < rows; row++) {
+            sources[row] = image.getRow<Format>(first_row + row);
+         }
+
+         /*
+          * The pixel in the defined row and column goes to the position
+          * (column, row), with the row of the result taken from the bottom
+          * when mirrored and its column taken from the right.
+          */
+         for (int first_column { 0 }; first_column < width;
+            first_column += ROTATE_TILE)
+         {
+            int last_column { std::min(first_column + ROTATE_TILE, width) };
+
+            for (int column { first_column }; column < last_column;
+               column++)
+            {
+               int offset { column * CHANNELS_PER_PIXEL };
+               Channel* destination {
+                  transpose.getRow<Format>(mirror_rows ?
+                     width - column - 1 : column)
+                  + start * CHANNELS_PER_PIXEL
+               };
+
+               for (int row { 0 }; row < rows; row++) {
+                  copyPixel(sources[row] + offset, destination + row * step);
+               }
+            }
          }
       }
 
-      Pixel filter_pixel { 
-         int(sum_red), 
-         int(sum_green), 
-         int(sum_blue), 
-         colors 
-      };
+      setImage(std::move(transpose));
+   }
 
-      return filter_pixel;
+   /**
+    * @brief Rotate the rows of the image to the right.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see transposeRows()
+    */
+   template <typename Format>
+   void rotateRightRows() {
+      transposeRows<Format>(false, true);
    }
 
    /**
-    * @public
-    * @brief Put a defined filter on the whole image.
-    * 
-    * @param mask Filter mask with the size defined by #MASK_SIZE x #MASK_SIZE.
-    * @see setImage() 
+    * @brief Rotate the rows of the image to the left.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see transposeRows()
+    */
+   template <typename Format>
+   void rotateLeftRows() {
+      transposeRows<Format>(true, false);
+   }
+
+   /**
+    * @brief Rotate the rows of the image by 180 degrees.
+    *
+    * @details Each row is reversed into the mirrored row, in one pass.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see reverseRow()
+    * @see setImage()
     */
-   void putOnMask(float mask[MASK_SIZE][MASK_SIZE]) {
+   template <typename Format>
+   void rotateHalfRows() {
       int width { image.getWidth() };
       int height { image.getHeight() };
 
-      Image mask_image { image.getType(), width, height, image.getColors() };
+      Image rotate { image.getType(), width, height, image.getColors() };
 
       for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
+         reverseRow(image.getRow<Format>(row), width,
+            rotate.getRow<Format>(height - row - 1));
+      }
+
+      setImage(std::move(rotate));
+   }
+
+   /**
+    * @brief Invert the rows of the image in place.
+    *
+    * @details The pixels are swapped inside each row, so no other image is
+    * allocated, and the rows are inverted in parallel bands.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see reverseChannels()
+    * @see forEachBand()
+    */
+   template <typename Format>
+   void invertRows() {
+      int width { image.getWidth() };
+
+      forEachBand(image.getHeight(), [&] (int first, int last) {
+         for (int row { first }; row < last; row++) {
+            reverseChannels(image.getRow<Format>(row), width);
+         }
+      });
+   }
+
+   /**
+    * @brief Flip the rows of the image upside down.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see setImage()
+    */
+   template <typename Format>
+   void flipRows() {
+      int height { image.getHeight() };
+      size_t row_size { image.getRowSize() };
+
+      Image flip { image.getType(), image.getWidth(), height,
+         image.getColors() };
+
+      for (int row { 0 }; row < height; row++) {
+         memcpy(flip.getRow<Format>(height - row - 1),
+            image.getRow<Format>(row), row_size);
+      }
+
+      setImage(std::move(flip));
+   }
+
+   /**
+    * @brief Resample the rows of the image to a new size.
+    *
+    * @details Each row of the new image is blended from rows of the image
+    * resampled across. The taps of the rows only move forward, so each
+    * band keeps the last resampled rows, one for each tap, instead of a
+    * whole image of them.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @param width Width of the new image.
+    * @param height Height of the new image.
+    * @param filter Resampling filter.
+    * @param truncate Whether the sums are truncated instead of rounded.
+    * @see getTaps()
+    * @see resampleRow()
+    * @see blendRows()
+    * @see setImage()
+    */
+   template <typename Format>
+   void resizeRows(int width, int height, Filters filter, bool truncate) {
+      typedef typename Format::Channel Channel;
+
+      int colors { image.getColors() };
+      size_t channels { (size_t) width * CHANNELS_PER_PIXEL };
+
+      Taps columns { getTaps(image.getWidth(), width, filter, truncate) };
+      Taps rows { getTaps(image.getHeight(), height, filter, truncate) };
+
+      Image resize { image.getType(), width, height, colors };
+
+      forEachBand(height, [&] (int first, int last) {
+         int slots { rows.count };
+
+         std::vector<Channel> cache(slots * channels);
+         std::vector<int> cached(slots, -1);
+         std::vector<Channel const*> sources(slots);
+         std::vector<int> weights(slots);
+
+         for (int row { first }; row < last; row++) {
+            int count { 0 };
+
             /*
-             * Put the filter on all pixels of the image through it with its 
-             * neighbors.
+             * The taps of a row are consecutive rows, so they never share a
+             * slot. The rows without weight are left out and the rows on
+             * the original ones are copied.
              */
-            Pixel pixels[MASK_SIZE][MASK_SIZE] = { 
-               { 
-                  image.getPixel(row - 1, column - 1), 
-                  image.getPixel(row - 1, column),
-                  image.getPixel(row - 1, column + 1) 
-               },
-               { 
-                  image.getPixel(row, column - 1), 
-                  image.getPixel(row, column),
-                  image.getPixel(row, column + 1) 
-               },
-               { 
-                  image.getPixel(row + 1, column - 1), 
-                  image.getPixel(row + 1, column),
-                  image.getPixel(row + 1, column + 1) 
-               } 
-            };
+            for (int tap { 0 }; tap < slots; tap++) {
+               int weight { rows.weights[tap * height + row] };
+               int source { rows.indices[tap * height + row] };
+
+               if (weight == 0) {
+                  continue;
+               }
+
+               Channel* resampled { &cache[source % slots * channels] };
+
+               if (cached[source % slots] != source) {
+                  resampleRow(image.getRow<Format>(source), columns, colors,
+                     resampled);
+                  cached[source % slots] = source;
+               }
+
+               sources[count] = resampled;
+               weights[count++] = weight;
+            }
+
+            blendRows(sources.data(), weights.data(), count, rows.bias,
+               channels, colors, resize.getRow<Format>(row));
+         }
+      });
+
+      setImage(std::move(resize));
+   }
+
+   /**
+    * @brief Reduce the rows of the image by averaging areas.
+    *
+    * @details Each row of the reduced image sums the rows of its box into
+    * a row of accumulators, once, then each pixel sums the accumulators of
+    * the columns of its box and divides by the weight of the whole box.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @tparam Sum Type of the accumulators, large enough for the colors
+    * times the weight of a whole box.
+    * @param columns Areas of the columns.
+    * @param rows Areas of the rows.
+    * @see setImage()
+    */
+   template <typename Format, typename Sum>
+   void reduceRows(Areas const& columns, Areas const& rows) {
+      typedef typename Format::Channel Channel;
+
+      int width { (int) columns.first.size() };
+      int height { (int) rows.first.size() };
+      Sum total { (Sum) (columns.total * rows.total) };
+
+      /*
+       * The boxes of a power of 2 of pixels, as when halving, are divided
+       * by a shift.
+       */
+      int shift { -1 };
+
+      if ((total & (total - 1)) == 0) {
+         for (shift = 0; ((Sum) 1 << shift) < total; shift++) { }
+      }
+
+      size_t used { width > 0 ? (size_t) (columns.first[width - 1]
+         + columns.offsets[width] - columns.offsets[width - 1])
+         * CHANNELS_PER_PIXEL : 0 };
+
+      Image reduce { image.getType(), width, height, image.getColors() };
+
+      forEachBand(height, [&] (int first, int last) {
+         std::vector<Sum> sums(used);
+         std::vector<Sum> boxes((size_t) width * CHANNELS_PER_PIXEL);
+
+         for (int row { first }; row < last; row++) {
+            for (int index { rows.offsets[row] };
+               index < rows.offsets[row + 1]; index++)
+            {
+               accumulateRow(image.getRow<Format>(rows.first[row] + index
+                  - rows.offsets[row]), (Sum) rows.weights[index],
+                  index == rows.offsets[row], used, sums.data());
+            }
+
+            Sum* box { boxes.data() };
+
+            for (int column { 0 }; column < width; column++) {
+               Sum const* sum {
+                  &sums[columns.first[column] * CHANNELS_PER_PIXEL]
+               };
+               Sum red { 0 };
+               Sum green { 0 };
+               Sum blue { 0 };
+
+               if (columns.whole && columns.total == 2) {
+                  red = sum[0] + sum[3];
+                  green = sum[1] + sum[4];
+                  blue = sum[2] + sum[5];
+               } else if (columns.whole) {
+                  for (int64_t index { 0 }; index < columns.total; index++) {
+                     red += sum[0];
+                     green += sum[1];
+                     blue += sum[2];
+                     sum += CHANNELS_PER_PIXEL;
+                  }
+               } else {
+                  for (int index { columns.offsets[column] };
+                     index < columns.offsets[column + 1]; index++)
+                  {
+                     Sum weight { (Sum) columns.weights[index] };
+
+                     red += sum[0] * weight;
+                     green += sum[1] * weight;
+                     blue += sum[2] * weight;
+                     sum += CHANNELS_PER_PIXEL;
+                  }
+               }
+
+               box[0] = red;
+               box[1] = green;
+               box[2] = blue;
+               box += CHANNELS_PER_PIXEL;
+            }
+
+            Channel* destination { reduce.getRow<Format>(row) };
+
+            if (shift >= 0) {
+               for (size_t channel { 0 }; channel < boxes.size(); channel++) {
+                  destination[channel] = (Channel) (boxes[channel] >> shift);
+               }
+            } else {
+               for (size_t channel { 0 }; channel < boxes.size(); channel++) {
+                  destination[channel] = (Channel) (boxes[channel] / total);
+               }
+            }
+         }
+      });
+
+      setImage(std::move(reduce));
+   }
+
+   /**
+    * @brief Combine the rows of a foreground image in the format of the
+    * image.
+    *
+    * @tparam Mask Format of the original foreground, #RGB8 or #RGB16.
+    * @param foreground Foreground image, with the colors of the image.
+    * @param mask Original foreground, before its colors were rescaled.
+    * @param x Displacement in X axis, not negative.
+    * @param y Displacement in Y axis, not negative.
+    * @see combineRows()
+    */
+   template <typename Mask>
+   void combineFormats(Image const& foreground, Image const& mask, int x,
+      int y)
+   {
+      if (image.isWide()) {
+         combineRows<RGB16, Mask>(foreground, mask, x, y);
+      } else {
+         combineRows<RGB8, Mask>(foreground, mask, x, y);
+      }
+   }
+
+   /**
+    * @brief Combine the rows of a foreground image with the maximum of colors
+    * of the image, placed inside it.
+    *
+    * @details The pixels equal to the first pixel of the original
+    * foreground are left out, compared before the colors were rescaled.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @tparam Mask Format of the original foreground, #RGB8 or #RGB16.
+    * @param foreground Foreground image, with the colors of the image.
+    * @param mask Original foreground, before its colors were rescaled.
+    * @param x Displacement in X axis, not negative.
+    * @param y Displacement in Y axis, not negative.
+    */
+   template <typename Format, typename Mask>
+   void combineRows(Image const& foreground, Image const& mask, int x, int y)
+   {
+      typedef typename Format::Channel Channel;
+      typedef typename Mask::Channel MaskChannel;
+
+      int width { std::min(getWidth() - x, foreground.getWidth()) };
+      int height { std::min(getHeight() - y, foreground.getHeight()) };
+
+      /* Pixel to ignore */
+      MaskChannel const* first_pixel { mask.getRow<Mask>(0) };
+
+      for (int row { 0 }; row < height; row++) {
+         Channel const* source { foreground.getRow<Format>(row) };
+         MaskChannel const* original { mask.getRow<Mask>(row) };
+         Channel* destination {
+            image.getRow<Format>(row + y) + x * CHANNELS_PER_PIXEL
+         };
+
+         for (int column { 0 }; column < width; column++) {
+            int offset { column * CHANNELS_PER_PIXEL };
+
+            if (original[offset] != first_pixel[0] ||
+               original[offset + 1] != first_pixel[1] ||
+               original[offset + 2] != first_pixel[2])
+            {
+               copyPixel(source + offset, destination + offset);
+            }
+         }
+      }
+   }
+
+   /**
+    * @brief Combine a foreground image with the image, pixel by pixel.
+    *
+    * @param foreground foreground image.
+    * @param x Displacement in X axis.
+    * @param y Displacement in Y axis
+    */
+   void combinePixels(Image const& foreground, int x, int y) {
+      int back_width { getWidth() };
+      int back_height { getHeight() };
+      int fore_width { foreground.getWidth() };
+      int fore_height { foreground.getHeight() };
+
+      Pixel first_pixel { foreground.getPixel(0, 0) }; /* Pixel to ignore */
+
+      for (int back_row { y }, fore_row { 0 };
+         back_row < back_height && fore_row < fore_height;
+         back_row++, fore_row++)
+      {
+         for (int back_column { x }, fore_column { 0 };
+            back_column < back_width && fore_column < fore_width;
+            back_column++, fore_column++)
+         {
+            Pixel pixel { foreground.getPixel(fore_row, fore_column) };
+
+            if (pixel != first_pixel) {
+               image.setPixel(pixel, back_row, back_column);
+            }
+         }
+      }
+   }
+
+   /**
+    * @brief Defines an outline around the rows of the image.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @param pixel An Pixel on the border, with the colors of the image.
+    * @param size Border size.
+    * @param additional_size Additional size for the bottom border.
+    * @see setImage()
+    */
+   template <typename Format>
+   void borderRows(Pixel const& pixel, int size, int additional_size) {
+      typedef typename Format::Channel Channel;
+
+      int image_width { getWidth() };
+      int image_height { getHeight() };
+      int width { image_width + 2 * size };
+      int height { image_height + 2 * size + additional_size };
+
+      Image border { image.getType(), width, height, getColors() };
+
+      Channel color[CHANNELS_PER_PIXEL] = {
+         (Channel) pixel.getRed(),
+         (Channel) pixel.getGreen(),
+         (Channel) pixel.getBlue()
+      };
+
+      for (int row { 0 }; row < height; row++) {
+         Channel* destination { border.getRow<Format>(row) };
+
+         if (row >= size && row < height - (size + additional_size)) {
+            for (int column { 0 }; column < size; column++) {
+               copyPixel(color, destination + column * CHANNELS_PER_PIXEL);
+            }
+
+            memcpy(destination + size * CHANNELS_PER_PIXEL,
+               image.getRow<Format>(std::min(row - size, image_height - 1)),
+               image.getRowSize());
 
-            mask_image.setPixel(putFilterOnPixel(pixels, mask), row, column);
+            for (int column { width - size }; column < width; column++) {
+               copyPixel(color, destination + column * CHANNELS_PER_PIXEL);
+            }
+         } else {
+            for (int column { 0 }; column < width; column++) {
+               copyPixel(color, destination + column * CHANNELS_PER_PIXEL);
+            }
          }
       }
 
-      setImage(mask_image);
+      setImage(std::move(border));
+   }
+
+   /**
+    * @brief Sum the channels around each pixel of a row.
+    *
+    * @details The sum of a pixel comes from the sum of the previous pixel,
+    * adding the channel that enters the window and taking the one that
+    * leaves it.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param row First channel of the row.
+    * @param width Pixels of the row.
+    * @param radius Pixels from the center to the side of the window.
+    * @param[out] sums Sum of each channel of the row.
+    */
+   template <typename Channel>
+   static void sumRow(Channel const* row, int width, int radius,
+      uint64_t* sums)
+   {
+      int last_column { width - 1 };
+
+      for (int index { 0 }; index < CHANNELS_PER_PIXEL; index++) {
+         uint64_t sum { 0 };
+
+         for (int column { -radius }; column <= radius; column++) {
+            int inside { std::min(std::max(column, 0), last_column) };
+            sum += row[inside * CHANNELS_PER_PIXEL + index];
+         }
+
+         sums[index] = sum;
+
+         for (int column { 1 }; column < width; column++) {
+            int entering { std::min(column + radius, last_column) };
+            int leaving { std::max(column - radius - 1, 0) };
+
+            sum += row[entering * CHANNELS_PER_PIXEL + index];
+            sum -= row[leaving * CHANNELS_PER_PIXEL + index];
+            sums[column * CHANNELS_PER_PIXEL + index] = sum;
+         }
+      }
+   }
+
+   /**
+    * @brief Blur the rows of the image with running sums.
+    *
+    * @details The sums of the windows of each row are added to the sums of
+    * the columns when the row enters the square and taken when it leaves
+    * it, so only the columns sums are kept between rows. Each band of rows
+    * runs in parallel and starts its own sums.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @param radius Pixels from the center to the side of the square.
+    * @see sumRow()
+    * @see forEachBand()
+    * @see setImage()
+    */
+   template <typename Format>
+   void blurRows(int radius) {
+      typedef typename Format::Channel Channel;
+
+      int width { image.getWidth() };
+      int height { image.getHeight() };
+      int last_row { height - 1 };
+      size_t channels { (size_t) width * CHANNELS_PER_PIXEL };
+      uint64_t area { (uint64_t) (2 * radius + 1) * (2 * radius + 1) };
+
+      Image blur { image.getType(), width, height, image.getColors() };
+
+      forEachBand(height, [&] (int first, int last) {
+         std::vector<uint64_t> columns(channels, 0);
+         std::vector<uint64_t> entering(channels);
+         std::vector<uint64_t> leaving(channels);
+
+         for (int row { first - radius }; row <= first + radius; row++) {
+            int inside { std::min(std::max(row, 0), last_row) };
+            sumRow(image.getRow<Format>(inside), width, radius,
+               entering.data());
+
+            for (size_t index { 0 }; index < channels; index++) {
+               columns[index] += entering[index];
+            }
+         }
+
+         for (int row { first }; row < last; row++) {
+            if (row > first) {
+               sumRow(image.getRow<Format>(std::min(row + radius, last_row)),
+                  width, radius, entering.data());
+               sumRow(image.getRow<Format>(std::max(row - radius - 1, 0)),
+                  width, radius, leaving.data());
+
+               for (size_t index { 0 }; index < channels; index++) {
+                  columns[index] += entering[index] - leaving[index];
+               }
+            }
+
+            Channel* destination { blur.getRow<Format>(row) };
+
+            for (size_t index { 0 }; index < channels; index++) {
+               destination[index] = (Channel) (columns[index] / area);
+            }
+         }
+      });
+
+      setImage(std::move(blur));
+   }
+
+   /**
+    * @brief Put a mask on the rows of the image.
+    *
+    * @details Rows outside the image are taken from the nearest edge, so
+    * each row picks its neighbors once and convolveRow() handles the
+    * columns. The rows are filtered in parallel bands.
+    *
+    * @tparam Mask Mask of the effect, see Convolution.hpp.
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @see convolveRow()
+    * @see forEachBand()
+    * @see setImage()
+    */
+   template <typename Mask, typename Format>
+   void convolveRows() {
+      typedef typename Format::Channel Channel;
+
+      int width { image.getWidth() };
+      int height { image.getHeight() };
+      int colors { image.getColors() };
+
+      Image mask_image { image.getType(), width, height, colors };
+
+      forEachBand(height, [&] (int first, int last) {
+         for (int row { first }; row < last; row++) {
+            Channel const* const rows[MASK_SIZE] = {
+               image.getRow<Format>(row > 0 ? row - 1 : 0),
+               image.getRow<Format>(row),
+               image.getRow<Format>(row < height - 1 ? row + 1 : row)
+            };
+
+            convolveRow<Mask>(rows, width, colors,
+               mask_image.getRow<Format>(row));
+         }
+      });
+
+      setImage(std::move(mask_image));
    }
 
    /**
     * @brief Writes a single glyph at the specified position.
+    *
+    * @details The glyph may pass the edges of the image, so its pixels go
+    * through the clamping accessor.
     * 
     * @param glyph Glyph memory position.
     * @param color Glyph color.
@@ -11,14 +11,25 @@
 #ifndef FONT_HPP
 #define FONT_HPP
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 #include "Glyph.hpp"
 
+#define DENSE_ENCODINGS 256 /**< Encodings indexed by position, Latin-1 */
+
 /**
  * @class Font class.
  * @author André Maurício (andre@dimap.ufrn.br)
  * @brief Font definition with attributes and methods.
+ *
+ * @details The glyphs are indexed by encoding when the font is read: the
+ * first #DENSE_ENCODINGS encodings by position and the others in a table
+ * sorted by encoding. An encoding without glyph takes the fallback glyph
+ * of the font, its DEFAULT_CHAR, "?" or a space, or an empty glyph.
  */
 class Font {
 public:
@@ -37,10 +48,30 @@ public:
     * @param filename Font filename.
     * @see readBDF()
     */
-   Font(std::string const filename) : name("") {
+   Font(std::string const filename) : name(""), glyphs(nullptr) {
       readBDF(filename);
    }
 
+   /**
+    * @brief Construct a new Font object with another font (copy).
+    *
+    * @param rhs A font to copy.
+    * @see copyFont()
+    */
+   Font(Font const& rhs) : num_glyphs(0), glyphs(nullptr) {
+      copyFont(rhs);
+   }
+
+   /**
+    * @brief Construct a new Font object with another font (move).
+    *
+    * @param rhs A font to move.
+    * @see takeFont()
+    */
+   Font(Font&& rhs) : num_glyphs(0), glyphs(nullptr) {
+      takeFont(rhs);
+   }
+
    /**
     * @brief Destroy the Font object.
     */
@@ -50,24 +81,61 @@ public:
       }
    }
 
+   /**
+    * @brief Operator to receive a font (copy).
+    *
+    * @param rhs A font to receive.
+    * @return This font.
+    * @see copyFont()
+    */
+   Font& operator=(Font const& rhs) {
+      if (this != &rhs) {
+         copyFont(rhs);
+      }
+
+      return *this;
+   }
+
+   /**
+    * @brief Operator to receive a font (move).
+    *
+    * @param rhs A font to move.
+    * @return This font.
+    * @see takeFont()
+    */
+   Font& operator=(Font&& rhs) {
+      if (this != &rhs) {
+         takeFont(rhs);
+      }
+
+      return *this;
+   }
+
    /**
     * @brief Read a BDF file and store the glyphs.
     * 
     * @param filename Font filename.
+    * @throw std::runtime_error If the file can not be read.
     */
    void readBDF(std::string const filename) {
       int count_glyphs = 0;
+      int default_char = -1;
       std::ifstream file(filename);
 
       if (!file.is_open()) {
-         std::cerr << "Reading error!" << std::endl;
-         abort();
+         throw std::runtime_error("Reading error! " + filename);
       }
 
       std::string prop = "";
 
       while (prop != "CHARS") {
-         file >> prop;
+         if (prop == "DEFAULT_CHAR") {
+            file >> default_char;
+         }
+
+         if (!(file >> prop)) {
+            throw std::runtime_error("Reading error! " + filename);
+         }
       }
 
       file >> num_glyphs;
@@ -82,27 +150,163 @@ public:
       }
 
       file.close();
+
+      indexGlyphs(default_char);
    }
 
    /**
     * @brief Find the glyph referring to an encoding.
     * 
     * @param encoding Encoding to search.
-    * @return Pointer to glyph.
+    * @return Pointer to glyph, or to the fallback glyph when the font has
+    * none for the encoding. Never nullptr.
+    * @see findGlyph()
     */
    Glyph const* getGlyph(int encoding) const {
-      for (int i = 0; i < num_glyphs; i++) {
-      if (glyphs[i].getEncoding() == encoding) {
-         return &glyphs[i];
+      int index { findGlyph(encoding) };
+
+      if (index < 0) {
+         index = fallback;
       }
+
+      return index < 0 ? &empty : &glyphs[index];
    }
-   return nullptr;
+
+   /**
+    * @brief Checks if the font has a glyph for an encoding.
+    * 
+    * @param encoding Encoding to search.
+    * @return An boolean.
+    */
+   bool hasGlyph(int encoding) const {
+      return findGlyph(encoding) >= 0;
    }
 
 private:
-   std::string name; /**< Name */
-   int num_glyphs;   /**< Number of glyphs */
-   Glyph* glyphs;    /**< Glyphs */
+   /**
+    * @brief Index the glyphs by encoding and pick the fallback glyph.
+    *
+    * @details When many glyphs have an encoding, the first is kept, and
+    * the glyphs without encoding, of negative encodings, are left out.
+    *
+    * @param default_char Encoding of the DEFAULT_CHAR of the font, or -1.
+    */
+   void indexGlyphs(int default_char) {
+      dense.assign(DENSE_ENCODINGS, -1);
+      sparse.clear();
+
+      for (int i = 0; i < num_glyphs; i++) {
+         int encoding { glyphs[i].getEncoding() };
+
+         if (encoding >= 0 && encoding < DENSE_ENCODINGS) {
+            if (dense[encoding] < 0) {
+               dense[encoding] = i;
+            }
+         } else if (encoding >= DENSE_ENCODINGS) {
+            sparse.emplace_back(encoding, i);
+         }
+      }
+
+      /*
+       * The glyphs of an encoding stay in the order of the file, so the
+       * search finds the first of them.
+       */
+      std::stable_sort(sparse.begin(), sparse.end(),
+         [] (std::pair<int, int> const& a, std::pair<int, int> const& b) {
+            return a.first < b.first;
+         });
+
+      fallback = -1;
+
+      for (int encoding : { default_char, (int) '?', (int) ' ' }) {
+         if (fallback < 0) {
+            fallback = findGlyph(encoding);
+         }
+      }
+
+      if (fallback < 0 && num_glyphs > 0) {
+         fallback = 0;
+      }
+   }
+
+   /**
+    * @brief Find the position of the glyph of an encoding.
+    *
+    * @param encoding Encoding to search.
+    * @return The position in the glyphs, or -1 when there is none.
+    */
+   int findGlyph(int encoding) const {
+      if (encoding < 0) {
+         return -1;
+      } else if (encoding < DENSE_ENCODINGS) {
+         return dense.empty() ? -1 : dense[encoding];
+      }
+
+      auto found = std::lower_bound(sparse.begin(), sparse.end(),
+         std::make_pair(encoding, -1));
+
+      return found != sparse.end() && found->first == encoding ?
+         found->second : -1;
+   }
+
+   /**
+    * @brief Copy the name and the glyphs of another font.
+    *
+    * @param rhs Font to copy.
+    */
+   void copyFont(Font const& rhs) {
+      if (glyphs != nullptr) {
+         delete[] glyphs;
+         glyphs = nullptr;
+      }
+
+      name = rhs.name;
+      num_glyphs = rhs.num_glyphs;
+
+      if (rhs.glyphs != nullptr) {
+         glyphs = new Glyph[num_glyphs];
+
+         for (int i = 0; i < num_glyphs; i++) {
+            glyphs[i] = rhs.glyphs[i];
+         }
+      }
+
+      dense = rhs.dense;
+      sparse = rhs.sparse;
+      fallback = rhs.fallback;
+   }
+
+   /**
+    * @brief Take the name and the glyphs of another font, leaving it empty.
+    *
+    * @param rhs Font to take.
+    */
+   void takeFont(Font& rhs) {
+      if (glyphs != nullptr) {
+         delete[] glyphs;
+      }
+
+      name = std::move(rhs.name);
+      num_glyphs = rhs.num_glyphs;
+      glyphs = rhs.glyphs;
+      dense = std::move(rhs.dense);
+      sparse = std::move(rhs.sparse);
+      fallback = rhs.fallback;
+
+      rhs.num_glyphs = 0;
+      rhs.glyphs = nullptr;
+      rhs.dense.clear();
+      rhs.sparse.clear();
+      rhs.fallback = -1;
+   }
+
+   std::string name;                        /**< Name */
+   int num_glyphs;                          /**< Number of glyphs */
+   Glyph* glyphs;                           /**< Glyphs */
+   std::vector<int> dense;                  /**< Glyph of each encoding */
+   std::vector<std::pair<int, int>> sparse; /**< Encodings and glyphs */
+   int fallback { -1 };                     /**< Glyph of other encodings */
+   Glyph empty;                             /**< Glyph of fonts with none */
 };
 
 #endif // FONT_HPP
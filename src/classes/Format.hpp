@@ -0,0 +1,39 @@
+/**
+ * @file Format.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Pixel storage formats.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Packed formats used by the image storage. The bit depth of an image is
+ * chosen once from its maximum color value and every pixel is kept as a
+ * triplet of channels of that depth.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef FORMAT_HPP
+#define FORMAT_HPP
+
+#include <stdint.h>
+
+/**
+ * @struct RGB8 struct.
+ * @brief Three 8 bits channels per pixel, for images with up to 255 colors.
+ */
+struct RGB8 {
+   typedef uint8_t Channel;             /**< Type of a single channel */
+   static const int max_colors { 255 }; /**< Largest value of a channel */
+};
+
+/**
+ * @struct RGB16 struct.
+ * @brief Three 16 bits channels per pixel, for images with up to 65535
+ * colors.
+ */
+struct RGB16 {
+   typedef uint16_t Channel;              /**< Type of a single channel */
+   static const int max_colors { 65535 }; /**< Largest value of a channel */
+};
+
+#endif // FORMAT_HPP
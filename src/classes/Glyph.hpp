@@ -13,6 +13,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <string.h>
+#include <utility>
 
 /**
  * @class Glyph class.
@@ -34,6 +36,26 @@ public:
       device_width_y(0), 
       bitmap(nullptr) { }
 
+   /**
+    * @brief Construct a new Glyph object with another glyph (copy).
+    *
+    * @param rhs A glyph to copy.
+    * @see copyGlyph()
+    */
+   Glyph(Glyph const& rhs) : bitmap(nullptr) {
+      copyGlyph(rhs);
+   }
+
+   /**
+    * @brief Construct a new Glyph object with another glyph (move).
+    *
+    * @param rhs A glyph to move.
+    * @see takeGlyph()
+    */
+   Glyph(Glyph&& rhs) : bitmap(nullptr) {
+      takeGlyph(rhs);
+   }
+
    /**
     * @brief Destroy the Glyph object.
     */
@@ -43,6 +65,36 @@ public:
       }
    }
 
+   /**
+    * @brief Operator to receive a glyph (copy).
+    *
+    * @param rhs A glyph to receive.
+    * @return This glyph.
+    * @see copyGlyph()
+    */
+   Glyph& operator=(Glyph const& rhs) {
+      if (this != &rhs) {
+         copyGlyph(rhs);
+      }
+
+      return *this;
+   }
+
+   /**
+    * @brief Operator to receive a glyph (move).
+    *
+    * @param rhs A glyph to move.
+    * @return This glyph.
+    * @see takeGlyph()
+    */
+   Glyph& operator=(Glyph&& rhs) {
+      if (this != &rhs) {
+         takeGlyph(rhs);
+      }
+
+      return *this;
+   }
+
    /**
     * @brief Operator to check equality of two glyphs.
     *
@@ -195,6 +247,61 @@ public:
    bool getBit(int x, int y) const { return bitmap[y * width + x]; }
 
 private:
+   /**
+    * @brief Copy the properties and the bitmap of another glyph.
+    *
+    * @param rhs Glyph to copy.
+    */
+   void copyGlyph(Glyph const& rhs) {
+      name = rhs.name;
+      copyProperties(rhs);
+
+      if (bitmap != nullptr) {
+         delete[] bitmap;
+         bitmap = nullptr;
+      }
+
+      if (rhs.bitmap != nullptr) {
+         bitmap = new bool[width * height];
+         memcpy(bitmap, rhs.bitmap, width * height * sizeof(bool));
+      }
+   }
+
+   /**
+    * @brief Take the properties and the bitmap of another glyph, leaving it
+    * without bitmap.
+    *
+    * @param rhs Glyph to take.
+    */
+   void takeGlyph(Glyph& rhs) {
+      name = std::move(rhs.name);
+      copyProperties(rhs);
+
+      if (bitmap != nullptr) {
+         delete[] bitmap;
+      }
+
+      bitmap = rhs.bitmap;
+      rhs.bitmap = nullptr;
+      rhs.width = 0;
+      rhs.height = 0;
+   }
+
+   /**
+    * @brief Copy the numeric properties of another glyph.
+    *
+    * @param rhs Glyph to copy.
+    */
+   void copyProperties(Glyph const& rhs) {
+      encoding = rhs.encoding;
+      width = rhs.width;
+      height = rhs.height;
+      offset_x = rhs.offset_x;
+      offset_y = rhs.offset_y;
+      device_width_x = rhs.device_width_x;
+      device_width_y = rhs.device_width_y;
+   }
+
    std::string name;   /**< Name */
    int encoding;       /**< Encoding */
    int width;          /**< Bitmap width */
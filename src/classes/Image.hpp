@@ -14,18 +14,36 @@
 #ifndef IMAGE_HPP
 #define IMAGE_HPP
 
+#include <algorithm>
+#include <assert.h>
 #include <iostream>
+#include <limits.h>
+#include <string.h>
+#include <utility>
+#include <vector>
 #include "Pixel.hpp"
+#include "Format.hpp"
 
 #define ASCII_TYPE "P3"         /**< Ascii type for the ppm image */
 #define BINARY_TYPE "P6"        /**< Binary type for the ppm image */
 #define MIN_WIDTH 1             /**< Minimum width for a ppm image */
 #define MIN_HEIGHT 1            /**< Minimum height for a ppm image */
+#define MAX_WIDTH (INT_MAX / (CHANNELS_PER_PIXEL * 2))  /**< Maximum width */
+#define MAX_HEIGHT (INT_MAX / (CHANNELS_PER_PIXEL * 2)) /**< Maximum height */
 #define MAX_COLUMNS_PER_LINE 70 /**< Maximum columns per line */
 
 /**
  * @class Image class.
  * @brief Image definition with attributes and methods.
+ *
+ * @details The pixels are packed in a single buffer with the depth chosen
+ * from the maximum of colors: #RGB8 up to 255 colors and #RGB16 above it.
+ *
+ * There are two ways to reach the pixels. getPixel() and setPixel() clamp
+ * the position to the image, so they accept any row and column. The
+ * unchecked accessors and getRow() trust the position, which is only
+ * asserted in debug builds, and are meant for the inner loops of kernels.
+ * No stored channel is above the maximum of colors.
  */
 class Image {
 public:
@@ -33,7 +51,7 @@ public:
     * @brief Construct a new Image object with no data.
     */
    Image() {
-      pixels = nullptr;
+      data = nullptr;
    }
 
    /**
@@ -44,14 +62,14 @@ public:
     * @param height Image height.
     * @param colors Maximum of colors per pixel channel.
     * @see setType()
-    * @see setSize()
     * @see setColors()
+    * @see setSize()
     */
    Image(std::string type, int width, int height, int colors) {
-      pixels = nullptr;
+      data = nullptr;
       setType(type);
-      setSize(width, height);
       setColors(colors);
+      setSize(width, height);
    }
 
    /**
@@ -61,17 +79,19 @@ public:
     * @param width Image width.
     * @param height Image height.
     * @param colors Maximum of colors per pixel channel.
-    * @param pixels Image pixels.
+    * @param pixels Image pixels, row after row, without padding.
     * @see setType()
-    * @see setSize()
     * @see setColors()
+    * @see setSize()
     * @see setPixels()
     */
-   Image(std::string type, int width, int height, int colors, Pixel** pixels) {
-      pixels = nullptr;
+   Image(std::string type, int width, int height, int colors,
+      Pixel const* pixels)
+   {
+      data = nullptr;
       setType(type);
-      setSize(width, height);
       setColors(colors);
+      setSize(width, height);
       setPixels(pixels);
    }
 
@@ -81,49 +101,91 @@ public:
     * @param rhs A image to copy.
     * @see getType()
     * @see setType()
+    * @see getColors()
+    * @see setColors()
     * @see getWidth()
     * @see getHeight()
     * @see setSize()
-    * @see getColors()
-    * @see setColors()
-    * @see getPixels()
-    * @see setPixels()
+    * @see copyRows()
     */
    Image(Image const& rhs) {
-      pixels = nullptr;
+      data = nullptr;
       setType(rhs.getType());
-      setSize(rhs.getWidth(), rhs.getHeight());
       setColors(rhs.getColors());
-      setPixels(rhs.getPixels());
+      setSize(rhs.getWidth(), rhs.getHeight());
+      copyRows(rhs);
+   }
+
+   /**
+    * @brief Construct a new Image object with the pixels of another image
+    * (move).
+    *
+    * @details The buffer changes owner without being copied and the moved
+    * image is left empty.
+    *
+    * @param rhs A image to move.
+    * @see takePixels()
+    */
+   Image(Image&& rhs) {
+      data = nullptr;
+      takePixels(rhs);
    }
 
    /**
     * @brief Operator to receive a image (copy).
     *
+    * @details The data is taken as it is, without the conversion of
+    * setColors(), since the pixels are replaced. The buffer is allocated
+    * once, or kept when it already has the size of the other image.
+    *
     * @param rhs A image to receive.
-    * @see getType()
-    * @see setType()
-    * @see getWidth()
-    * @see getHeight()
+    * @return This image.
     * @see setSize()
-    * @see getColors()
-    * @see setColors()
-    * @see getPixels()
-    * @see setPixels()
+    * @see copyRows()
     */
-   void operator=(Image const& rhs) {
-      pixels = nullptr;
-      setType(rhs.getType());
-      setSize(rhs.getWidth(), rhs.getHeight());
-      setColors(rhs.getColors());
-      setPixels(rhs.getPixels());
+   Image& operator=(Image const& rhs) {
+      if (this == &rhs) {
+         return *this;
+      }
+
+      bool same_size { data != nullptr && depth == rhs.depth &&
+         width == rhs.width && height == rhs.height };
+
+      type = rhs.type;
+      colors = rhs.colors;
+      depth = rhs.depth;
+
+      if (!same_size) {
+         setSize(rhs.width, rhs.height);
+      }
+
+      copyRows(rhs);
+
+      return *this;
+   }
+
+   /**
+    * @brief Operator to receive a image (move).
+    *
+    * @param rhs A image to move.
+    * @return This image.
+    * @see deletePixels()
+    * @see takePixels()
+    */
+   Image& operator=(Image&& rhs) {
+      if (this != &rhs) {
+         deletePixels();
+         takePixels(rhs);
+      }
+
+      return *this;
    }
 
    /**
     * @brief Destroy the Image object.
     * @see deletePixels()
     */
-   ~Image() { 
+   ~Image() {
       deletePixels();
    }
 
@@ -132,17 +194,17 @@ public:
     *
     * @param rhs A image to check equality.
     * @return True if the images are equal or false if they are not equal.
-    * @see getPixel()
+    * @see getRowBytes()
     */
    bool operator==(Image const& rhs) const {
       if (type == rhs.getType() && width == rhs.getWidth() &&
-         height == rhs.getHeight() && colors == rhs.getColors()) 
+         height == rhs.getHeight() && colors == rhs.getColors())
       {
          for (int row { 0 }; row < height; row++) {
-            for (int column { 0 }; column < width; column++) {
-               if (getPixel(row, column) != rhs.getPixel(row, column)) {
-                  return false;
-               }
+            if (memcmp(getRowBytes(row), rhs.getRowBytes(row),
+               getRowSize()) != 0)
+            {
+               return false;
             }
          }
 
@@ -197,17 +259,17 @@ public:
 
    /**
     * @brief Set the image size.
-    * 
+    *
     * @param width Image width
     * @param height Image height.
-    * @see newPixels()
     * @see setWidth()
     * @see setHeight()
+    * @see newPixels()
     */
    void setSize(int width, int height) {
-      newPixels(width, height);
       setWidth(width);
       setHeight(height);
+      newPixels(this->width, this->height);
    }
 
    /**
@@ -219,20 +281,20 @@ public:
 
    /**
     * @brief Set the number of colors in the image.
-    * 
+    *
+    * @details When the new number of colors needs another depth, the
+    * storage is converted and the channels are kept (clamped to the new
+    * depth). The channels are not rescaled.
+    *
     * @param colors_image Maximum of colors per pixel channel.
+    * @see convertDepth()
     */
    void setColors(int colors_image) {
-      int max_colors { 0 };
-
-      if (type == ASCII_TYPE) {
-         max_colors = MAX_AMOUNT_COLORS;
-      } else {
-         max_colors = STANDARD_COLOR_QUANTIFY;
-      }
+      int max_colors { RGB16::max_colors };
+      int old_colors { colors };
 
       if (colors_image >= MIN_AMOUNT_COLORS &&
-         colors_image <= max_colors) 
+         colors_image <= max_colors)
       {
          colors = colors_image;
       } else if (colors_image < MIN_AMOUNT_COLORS) {
@@ -240,6 +302,54 @@ public:
       } else {
          colors = max_colors;
       }
+
+      int new_depth { colors > RGB8::max_colors ?
+         (int) sizeof(RGB16::Channel) : (int) sizeof(RGB8::Channel) };
+
+      if (new_depth != depth) {
+         convertDepth(new_depth);
+      }
+
+      if (colors < old_colors) {
+         clampChannels();
+      }
+   }
+
+   /**
+    * @brief Rescale the channels of the image to another number of colors.
+    *
+    * @details Gives the same channels as rescaling each pixel with
+    * Pixel::setColors(), but each level is rescaled once, into a table
+    * that then rescales the whole image in a single pass.
+    *
+    * @param colors_image Maximum of colors per pixel channel.
+    * @see Pixel::rescaleChannel()
+    * @see setColors()
+    */
+   void rescaleColors(int colors_image) {
+      int old_colors { colors };
+
+      /*
+       * The channels are rescaled in the deepest of both storages, so the
+       * depth grows before and shrinks after.
+       */
+      if (colors_image > old_colors) {
+         setColors(colors_image);
+      }
+
+      int max_colors { RGB16::max_colors };
+      int new_colors { std::max(std::min(colors_image, max_colors),
+         MIN_AMOUNT_COLORS) };
+
+      if (isWide()) {
+         rescaleChannels<RGB16>(old_colors, new_colors);
+      } else {
+         rescaleChannels<RGB8>(old_colors, new_colors);
+      }
+
+      if (colors_image < old_colors) {
+         setColors(colors_image);
+      }
    }
 
    /**
@@ -249,9 +359,26 @@ public:
     */
    int getColors() const { return colors; }
 
+   /**
+    * @brief Get the number of bytes of each channel.
+    *
+    * @return 1 for #RGB8 images or 2 for #RGB16 images.
+    */
+   int getDepth() const { return depth; }
+
+   /**
+    * @brief Checks if the image is stored with 16 bits channels.
+    *
+    * @return An boolean.
+    */
+   bool isWide() const { return depth == (int) sizeof(RGB16::Channel); }
+
    /**
     * @brief Defines a pixel in the image.
     *
+    * @details A pixel with another maximum of colors is rescaled to the
+    * colors of the image before it is stored.
+    *
     * @param pixel Pixel to define in the image.
     * @param row Row of the pixel to define in the image.
     * @param column Column of the pixel to define in the image.
@@ -269,7 +396,15 @@ public:
          column = width - 1;
       }
 
-      pixels[row][column] = pixel;
+      if (pixel.getMaxColors() != colors) {
+         pixel.setColors(colors);
+      }
+
+      if (isWide()) {
+         storePixel(getRow<RGB16>(row) + column * CHANNELS_PER_PIXEL, pixel);
+      } else {
+         storePixel(getRow<RGB8>(row) + column * CHANNELS_PER_PIXEL, pixel);
+      }
    }
 
    /**
@@ -292,77 +427,141 @@ public:
          column = width - 1;
       }
 
-      return pixels[row][column];
+      if (isWide()) {
+         return loadPixel(getRow<RGB16>(row) + column * CHANNELS_PER_PIXEL);
+      }
+
+      return loadPixel(getRow<RGB8>(row) + column * CHANNELS_PER_PIXEL);
    }
 
    /**
-    * @brief Get all image pixels.
+    * @brief Defines a pixel in the image, without clamping the position.
     *
-    * @return All pixels.
+    * @param pixel Pixel to define in the image.
+    * @param row Row of the pixel, between 0 and the height - 1.
+    * @param column Column of the pixel, between 0 and the width - 1.
+    * @see setPixel()
     */
-   Pixel** getPixels() const { return pixels; }
+   void setPixelUnchecked(Pixel pixel, int row, int column) {
+      assert(column >= 0 && column < width);
+
+      if (pixel.getMaxColors() != colors) {
+         pixel.setColors(colors);
+      }
+
+      if (isWide()) {
+         storePixel(getRow<RGB16>(row) + column * CHANNELS_PER_PIXEL, pixel);
+      } else {
+         storePixel(getRow<RGB8>(row) + column * CHANNELS_PER_PIXEL, pixel);
+      }
+   }
 
    /**
-    * @brief Set multiple pixels on the image.
+    * @brief Get an image pixel, without clamping the position.
     *
-    * @param pixels_image Image pixels to define in the image.
+    * @param row Row of the pixel, between 0 and the height - 1.
+    * @param column Column of the pixel, between 0 and the width - 1.
+    * @return An pixel.
+    * @see getPixel()
     */
-   void setPixels(Pixel** image_pixels) {
-      for (int row { 0 }; row < height; row++) {
-         for (int column { 0 }; column < width; column++) {
-            pixels[row][column] = image_pixels[row][column];
-         }
+   Pixel getPixelUnchecked(int row, int column) const {
+      assert(column >= 0 && column < width);
+
+      if (isWide()) {
+         return loadPixel(getRow<RGB16>(row) + column * CHANNELS_PER_PIXEL);
       }
+
+      return loadPixel(getRow<RGB8>(row) + column * CHANNELS_PER_PIXEL);
+   }
+
+   /**
+    * @brief Get the number of channels between the start of two consecutive
+    * rows.
+    *
+    * @return An integer.
+    */
+   int getStride() const { return stride; }
+
+   /**
+    * @brief Get the first channel of a row.
+    *
+    * @details The row holds the red, green and blue channels of #width
+    * pixels side by side and the next row starts #stride channels later, so
+    * kernels can walk the image with plain pointer arithmetic. The format
+    * must match getDepth() and the row is not clamped.
+    *
+    * @tparam Format #RGB8 or #RGB16.
+    * @param row Row of the image.
+    * @return Pointer to the red channel of the pixel in the first column.
+    */
+   template <typename Format>
+   typename Format::Channel* getRow(int row) {
+      assert(sizeof(typename Format::Channel) == (size_t) depth);
+      assert(row >= 0 && row < height);
+
+      return reinterpret_cast<typename Format::Channel*>(data) +
+         (size_t) row * stride;
    }
 
    /**
-    * @brief Transform the image data into a string.
+    * @brief Get the first channel of a row (read only).
     *
-    * @return A string with separated image informations.
+    * @tparam Format #RGB8 or #RGB16.
+    * @param row Row of the image.
+    * @return Pointer to the red channel of the pixel in the first column.
     */
-   std::string toString() const {
-      std::string width_str { std::to_string(width) };
-      std::string height_str { std::to_string(height) };
-      std::string colors_str { std::to_string(colors) };
+   template <typename Format>
+   typename Format::Channel const* getRow(int row) const {
+      assert(sizeof(typename Format::Channel) == (size_t) depth);
+      assert(row >= 0 && row < height);
 
-      std::string separator { " " };
-      std::string endline { "\n" };
+      return reinterpret_cast<typename Format::Channel const*>(data) +
+         (size_t) row * stride;
+   }
 
-      std::string buff { type + endline };
-      buff += width_str + separator + height_str + endline;
-      buff += colors_str + endline;
+   /**
+    * @brief Get the first byte of a row, whatever the depth.
+    *
+    * @param row Row of the image.
+    * @return Pointer to the first byte of the row.
+    */
+   unsigned char* getRowBytes(int row) {
+      return data + (size_t) row * stride * depth;
+   }
 
-      std::string buff_line { "" };
+   /**
+    * @brief Get the first byte of a row, whatever the depth (read only).
+    *
+    * @param row Row of the image.
+    * @return Pointer to the first byte of the row.
+    */
+   unsigned char const* getRowBytes(int row) const {
+      return data + (size_t) row * stride * depth;
+   }
+
+   /**
+    * @brief Get the number of bytes used by the pixels of a row.
+    *
+    * @return An integer.
+    */
+   size_t getRowSize() const {
+      return (size_t) width * CHANNELS_PER_PIXEL * depth;
+   }
 
+   /**
+    * @brief Set multiple pixels on the image.
+    *
+    * @param image_pixels Image pixels, row after row, without padding.
+    * @see setPixel()
+    */
+   void setPixels(Pixel const* image_pixels) {
       for (int row { 0 }; row < height; row++) {
+         Pixel const* source { image_pixels + (size_t) row * width };
+
          for (int column { 0 }; column < width; column++) {
-            Pixel pixel { pixels[row][column] };
-            std::string pixel_str { };
-
-            if (type == BINARY_TYPE) {
-               pixel_str += (char) pixel.getRed();
-               pixel_str += (char) pixel.getGreen();
-               pixel_str += (char) pixel.getBlue();
-
-               buff_line += pixel_str;
-            } else {
-               pixel_str = std::to_string(pixel.getRed()) + separator +
-                  std::to_string(pixel.getGreen()) + separator +
-                  std::to_string(pixel.getBlue()) + separator;
-
-               if ((buff_line + pixel_str).size() <= MAX_COLUMNS_PER_LINE) {
-                  buff_line += pixel_str;
-               } else {
-                  buff += buff_line + endline;
-                  buff_line = pixel_str;
-               }
-            }
+            setPixel(source[column], row, column);
          }
       }
-
-      buff += buff_line;
-
-      return buff;
    }
 
 private:
@@ -370,12 +569,14 @@ private:
    int width { 0 };     /**< Image width */
    int height { 0 };    /**< Image height */
    int colors { 0 };    /**< Number of colors in image */
-   Pixel** pixels;      /**< Pixels vector */
+   int depth { 1 };     /**< Bytes per channel */
+   int stride { 0 };    /**< Channels between the start of two rows */
+   unsigned char* data; /**< Contiguous pixels buffer */
 
    /**
     * @public
     * @brief Set the image width.
-    * 
+    *
     * @param width_image Image width.
     */
    void setWidth(int width_image) {
@@ -388,7 +589,7 @@ private:
    /**
     * @public
     * @brief Set the image height.
-    * 
+    *
     * @param height_image Image height.
     */
    void setHeight(int height_image) {
@@ -400,8 +601,184 @@ private:
    }
 
    /**
-    * @brief Dynamically allocates the array to the pixels of the image.
-    * 
+    * @brief Write the channels of a pixel in the storage.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param destination First channel of the pixel.
+    * @param pixel Pixel with the colors of the image.
+    */
+   template <typename Channel>
+   static void storePixel(Channel* destination, Pixel const& pixel) {
+      destination[0] = (Channel) pixel.getRed();
+      destination[1] = (Channel) pixel.getGreen();
+      destination[2] = (Channel) pixel.getBlue();
+   }
+
+   /**
+    * @brief Read the channels of a pixel in the storage.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param source First channel of the pixel.
+    * @return A pixel with the colors of the image.
+    */
+   template <typename Channel>
+   Pixel loadPixel(Channel const* source) const {
+      return Pixel { source[0], source[1], source[2], colors };
+   }
+
+   /**
+    * @brief Copy the pixels of an image with the same size and depth, row
+    * by row.
+    *
+    * @param rhs Image to copy.
+    * @see getRowBytes()
+    */
+   void copyRows(Image const& rhs) {
+      for (int row { 0 }; row < height; row++) {
+         memcpy(getRowBytes(row), rhs.getRowBytes(row), getRowSize());
+      }
+   }
+
+   /**
+    * @brief Take the data and the buffer of another image, leaving it empty.
+    *
+    * @param rhs Image that gives the buffer.
+    */
+   void takePixels(Image& rhs) {
+      type = std::move(rhs.type);
+      width = rhs.width;
+      height = rhs.height;
+      colors = rhs.colors;
+      depth = rhs.depth;
+      stride = rhs.stride;
+      data = rhs.data;
+
+      rhs.width = 0;
+      rhs.height = 0;
+      rhs.stride = 0;
+      rhs.data = nullptr;
+   }
+
+   /**
+    * @brief Change the bytes per channel, keeping the channels.
+    *
+    * @param new_depth New bytes per channel.
+    * @see newPixels()
+    */
+   void convertDepth(int new_depth) {
+      unsigned char* old_data { data };
+      int old_depth { depth };
+
+      data = nullptr;
+      depth = new_depth;
+
+      if (old_data == nullptr) {
+         return;
+      }
+
+      newPixels(width, height);
+
+      size_t channels { (size_t) stride * height };
+
+      if (isWide()) {
+         RGB16::Channel* destination { getRow<RGB16>(0) };
+         RGB8::Channel const* source { old_data };
+
+         for (size_t index { 0 }; index < channels; index++) {
+            destination[index] = source[index];
+         }
+      } else if (old_depth != depth) {
+         RGB8::Channel* destination { getRow<RGB8>(0) };
+         RGB16::Channel const* source { 
+            reinterpret_cast<RGB16::Channel const*>(old_data) 
+         };
+
+         for (size_t index { 0 }; index < channels; index++) {
+            destination[index] = source[index] > RGB8::max_colors ?
+               RGB8::max_colors : source[index];
+         }
+      }
+
+      delete[] old_data;
+   }
+
+   /**
+    * @brief Limit the stored channels to the maximum of colors.
+    *
+    * @details Kernels read the channels straight from the rows, so no
+    * channel is kept above the maximum of colors.
+    */
+   void clampChannels() {
+      if (data == nullptr) {
+         return;
+      }
+
+      size_t channels { (size_t) stride * height };
+
+      if (isWide()) {
+         clampChannels(getRow<RGB16>(0), channels);
+      } else {
+         clampChannels(getRow<RGB8>(0), channels);
+      }
+   }
+
+   /**
+    * @brief Limit some channels to the maximum of colors.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param channel First channel.
+    * @param channels Number of channels.
+    */
+   template <typename Channel>
+   void clampChannels(Channel* channel, size_t channels) {
+      Channel maximum { (Channel) colors };
+
+      for (size_t index { 0 }; index < channels; index++) {
+         if (channel[index] > maximum) {
+            channel[index] = maximum;
+         }
+      }
+   }
+
+   /**
+    * @brief Rescale all channels through a table of the levels.
+    *
+    * @tparam Format Format of the image, #RGB8 or #RGB16.
+    * @param old_colors Maximum of colors of the channels.
+    * @param new_colors Maximum of colors to rescale to.
+    */
+   template <typename Format>
+   void rescaleChannels(int old_colors, int new_colors) {
+      typedef typename Format::Channel Channel;
+
+      size_t channels { (size_t) stride * height };
+
+      if (data == nullptr || channels == 0 || old_colors == new_colors) {
+         return;
+      }
+
+      std::vector<Channel> table(old_colors + 1);
+
+      for (int level { 0 }; level <= old_colors; level++) {
+         int channel { Pixel::rescaleChannel(level, old_colors, new_colors) };
+
+         table[level] = (Channel) std::max(std::min(channel, new_colors),
+            MIN_COLOR);
+      }
+
+      Channel* channel { getRow<Format>(0) };
+
+      for (size_t index { 0 }; index < channels; index++) {
+         channel[index] = table[channel[index]];
+      }
+   }
+
+   /**
+    * @brief Dynamically allocates a single buffer to the pixels of the image.
+    *
+    * @details All rows live in one allocation, one after the other, with
+    * #stride channels between the start of two rows.
+    *
     * @param new_width New image width.
     * @param new_height New image height.
     * @see deletePixels()
@@ -409,26 +786,19 @@ private:
    void newPixels(int new_width, int new_height) {
       deletePixels();
 
-      pixels = new Pixel*[new_height];
-
-      for (int row { 0 }; row < new_height; row++) {
-         pixels[row] = new Pixel[new_width];
-      }
+      stride = new_width * CHANNELS_PER_PIXEL;
+      data = new unsigned char[(size_t) stride * new_height * depth]();
    }
 
    /**
-    * @brief Deletes the dynamically allocated arrays for the image pixels.
+    * @brief Deletes the dynamically allocated buffer for the image pixels.
     */
    void deletePixels() {
-      if (pixels != nullptr) {
-         for (int row { 0 }; row < height; row++) {
-            delete[] pixels[row];
-         }
-
-         delete[] pixels;
+      if (data != nullptr) {
+         delete[] data;
       }
 
-      pixels = nullptr;
+      data = nullptr;
    }
 };
 
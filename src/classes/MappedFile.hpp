@@ -0,0 +1,153 @@
+/**
+ * @file MappedFile.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Files mapped to memory for writing.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Creates a file of a known size, with all of its blocks allocated, and
+ * maps it to memory, so its bytes are written in place by any thread.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <stddef.h>
+#include <string>
+
+#if defined(__linux__)
+#define MAPPED_FILES /**< Files mapped with the calls of POSIX */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class MappedFile class.
+ * @brief MappedFile definition with attributes and methods.
+ *
+ * @details The file is allocated before it is mapped, so a full disk is
+ * found when it is opened instead of when a byte is written. Only regular
+ * files are mapped, and systems without the calls never map a file, so
+ * the callers keep a way to write to streams.
+ */
+class MappedFile {
+public:
+   /**
+    * @brief Construct a new MappedFile object with no file.
+    */
+   MappedFile() { }
+
+   MappedFile(MappedFile const&) = delete;
+   MappedFile& operator=(MappedFile const&) = delete;
+
+   /**
+    * @brief Destroy the MappedFile object, closing its file.
+    * @see close()
+    */
+   ~MappedFile() {
+      close();
+   }
+
+   /**
+    * @brief Create or truncate a file to a size and map it.
+    *
+    * @param path Path of the file.
+    * @param file_size Bytes of the file, above 0.
+    * @return True if the file is mapped or false if it is not, leaving no
+    * file open.
+    */
+   bool open(std::string path, size_t file_size) {
+      close();
+
+#ifdef MAPPED_FILES
+      descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0666);
+
+      if (descriptor < 0) {
+         return false;
+      }
+
+      struct stat status;
+
+      if (file_size == 0 || fstat(descriptor, &status) != 0 ||
+         !S_ISREG(status.st_mode) ||
+         ftruncate(descriptor, (off_t) file_size) != 0 ||
+         posix_fallocate(descriptor, 0, (off_t) file_size) != 0)
+      {
+         close();
+         return false;
+      }
+
+      void* mapping { mmap(nullptr, file_size, PROT_READ | PROT_WRITE,
+         MAP_SHARED, descriptor, 0) };
+
+      if (mapping == MAP_FAILED) {
+         close();
+         return false;
+      }
+
+      data = (unsigned char*) mapping;
+      size = file_size;
+
+      return true;
+#else
+      (void) path;
+      (void) file_size;
+
+      return false;
+#endif
+   }
+
+   /**
+    * @brief Get the bytes of the file.
+    *
+    * @return A pointer to the first byte, or nullptr with no file mapped.
+    */
+   unsigned char* getData() { return data; }
+
+   /**
+    * @brief Get the size of the file.
+    *
+    * @return The bytes of the file, or 0 with no file mapped.
+    */
+   size_t getSize() const { return size; }
+
+   /**
+    * @brief Write the mapped bytes back, unmap and close the file.
+    *
+    * @details The bytes are synchronized before the unmap, so the errors
+    * of the write back are found here instead of being lost.
+    *
+    * @return True if the file was written or false if an error was found.
+    */
+   bool close() {
+      bool closed { true };
+
+#ifdef MAPPED_FILES
+      if (data != nullptr) {
+         closed = msync(data, size, MS_SYNC) == 0;
+         closed = munmap(data, size) == 0 && closed;
+      }
+
+      if (descriptor >= 0) {
+         closed = ::close(descriptor) == 0 && closed;
+      }
+#endif
+
+      data = nullptr;
+      size = 0;
+      descriptor = -1;
+
+      return closed;
+   }
+
+private:
+   unsigned char* data { nullptr }; /**< Bytes of the file mapped */
+   size_t size { 0 };               /**< Bytes of the file */
+   int descriptor { -1 };           /**< Descriptor of the open file */
+};
+
+#endif // MAPPED_FILE_HPP
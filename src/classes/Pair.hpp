@@ -14,6 +14,8 @@
 #ifndef PAIR_HPP
 #define PAIR_HPP
 
+#include <utility>
+
 /**
  * @class Pair class.
  * @brief Pair definition with attributes and methods.
@@ -38,7 +40,9 @@ public:
     * @param desc Description of the pair.
     * @param val Value of the pair.
     */
-   Pair(Description desc, Value val) : description(desc), value(val) { }
+   Pair(Description desc, Value val) : 
+      description(std::move(desc)), 
+      value(std::move(val)) { }
    
    /**
     * @brief Construct a new Pair object with another pair (copy).
@@ -52,6 +56,15 @@ public:
       setValue(rhs.getValue());
    }
 
+   /**
+    * @brief Construct a new Pair object with another pair (move).
+    *
+    * @param rhs A pair to move.
+    */
+   Pair(Pair&& rhs) : 
+      description(std::move(rhs.description)), 
+      value(std::move(rhs.value)) { }
+
    /**
     * @brief Destroy the pair object.
     */
@@ -61,12 +74,28 @@ public:
     * @brief Operator to receive a pair (copy).
     *
     * @param rhs A pair to receive.
+    * @return This pair.
     * @see setDescription()
     * @see setValue()
     */
-   void operator=(Pair const& rhs) {
+   Pair& operator=(Pair const& rhs) {
       setDescription(rhs.getDescription());
       setValue(rhs.getValue());
+
+      return *this;
+   }
+
+   /**
+    * @brief Operator to receive a pair (move).
+    *
+    * @param rhs A pair to move.
+    * @return This pair.
+    */
+   Pair& operator=(Pair&& rhs) {
+      description = std::move(rhs.description);
+      value = std::move(rhs.value);
+
+      return *this;
    }
 
    /**
@@ -75,15 +104,15 @@ public:
     * @param desc Description.
     */
    void setDescription(Description desc) {
-      description = desc;
+      description = std::move(desc);
    }
 
    /**
     * @brief Get the description of the pair.
     * 
-    * @return An Description value.
+    * @return An Description value (read only).
     */
-   Description getDescription() const {
+   Description const& getDescription() const {
       return description;
    }
    
@@ -93,15 +122,15 @@ public:
     * @param val Value.
     */
    void setValue(Value val) {
-      value = val;
+      value = std::move(val);
    }
 
    /**
     * @brief Get the value of the pair.
     * 
-    * @return An Value value.
+    * @return An Value value (read only).
     */
-   Value getValue() const {
+   Value const& getValue() const {
       return value;
    }
 
@@ -42,7 +42,7 @@ public:
     * @param blue_intensity Blue intensity in the pixel.
     * @param maximum_colors Maximum of colors per channel in a pixel.
     * Default is #STANDARD_COLOR_QUANTIFY.
-    * @see setColors()
+    * @see setMaxColors()
     * @see setRed()
     * @see setGreen()
     * @see setBlue()
@@ -50,7 +50,7 @@ public:
    Pixel(int red_intensity, int green_intensity, int blue_intensity,
       int maximum_colors = STANDARD_COLOR_QUANTIFY) 
    {
-      setColors(maximum_colors);
+      setMaxColors(maximum_colors);
       setRed(red_intensity);
       setGreen(green_intensity);
       setBlue(blue_intensity);
@@ -61,7 +61,7 @@ public:
     *
     * @param rhs A pixel to copy.
     * @see getMaxColors()
-    * @see setColors()
+    * @see setMaxColors()
     * @see getRed()
     * @see setRed()
     * @see getGreen()
@@ -70,7 +70,7 @@ public:
     * @see setBlue()
     */
    Pixel(Pixel const& rhs) {
-      setColors(rhs.getMaxColors());
+      setMaxColors(rhs.getMaxColors());
       setRed(rhs.getRed());
       setGreen(rhs.getGreen());
       setBlue(rhs.getBlue());
@@ -81,7 +81,7 @@ public:
     *
     * @param rhs A pixel to receive.
     * @see getMaxColors()
-    * @see setColors()
+    * @see setMaxColors()
     * @see getRed()
     * @see setRed()
     * @see getGreen()
@@ -90,7 +90,7 @@ public:
     * @see setBlue()
     */
    void operator=(Pixel const& rhs) {
-      setColors(rhs.getMaxColors());
+      setMaxColors(rhs.getMaxColors());
       setRed(rhs.getRed());
       setGreen(rhs.getGreen());
       setBlue(rhs.getBlue());
@@ -231,43 +231,34 @@ public:
     * channel.
     * 
     * @param maximum_colors Maximum of colors per channel in a pixel.
-    * @param red_intensity Red intensity in the pixel. Default is 0.
-    * @param green_intensity Green intensity in the pixel. Default is 0.
-    * @param blue_intensity Blue intensity in the pixel. Default is 0.
+    * @see rescaleChannel()
     */
    void setColors(int maximum_colors) {
-      int new_red { 
-         (int) round(
-            ((float) red /  max_colors) * maximum_colors
-         ) 
-      };
-      int new_green { 
-         (int) round(
-            ((float) green /  max_colors) * maximum_colors
-         ) 
-      };
-      int new_blue { 
-         (int) round(
-            ((float) blue /  max_colors) * maximum_colors
-         ) 
-      };
-
-      if (maximum_colors >= MIN_AMOUNT_COLORS
-         && maximum_colors <= MAX_AMOUNT_COLORS) {
-         max_colors = maximum_colors;
-      } else if (maximum_colors < MIN_AMOUNT_COLORS) {
-         max_colors = MIN_AMOUNT_COLORS;
-      } else {
-         max_colors = MAX_AMOUNT_COLORS;
-      }
-
-      
+      int new_red { rescaleChannel(red, max_colors, maximum_colors) };
+      int new_green { rescaleChannel(green, max_colors, maximum_colors) };
+      int new_blue { rescaleChannel(blue, max_colors, maximum_colors) };
 
+      setMaxColors(maximum_colors);
       setRed(new_red);
       setGreen(new_green);
       setBlue(new_blue);
    }
 
+   /**
+    * @brief Rescale a channel intensity to another maximum of colors.
+    *
+    * @details The rounding of setColors(), shared with the tables that
+    * rescale whole images.
+    *
+    * @param intensity Intensity of the channel.
+    * @param colors Maximum of colors of the intensity.
+    * @param maximum_colors Maximum of colors to rescale to.
+    * @return The rescaled intensity, not yet limited to the colors.
+    */
+   static int rescaleChannel(int intensity, int colors, int maximum_colors) {
+      return (int) round(((float) intensity / colors) * maximum_colors);
+   }
+
    /**
     * @brief Transform the pixel data into a string.
     *
@@ -296,6 +287,25 @@ private:
    int red { 0 };                /**< Intensity of red in the pixel */
    int green { 0 };              /**< Intensity of green in the pixel */
    int blue { 0 };               /**< Intensity of blue in the pixel */
+
+   /**
+    * @brief Set the maximum of colors, without rescaling the channels.
+    *
+    * @details Used when all channels are set right after, so the copies
+    * of pixels skip the rescaling.
+    *
+    * @param maximum_colors Maximum of colors per channel in a pixel.
+    */
+   void setMaxColors(int maximum_colors) {
+      if (maximum_colors >= MIN_AMOUNT_COLORS
+         && maximum_colors <= MAX_AMOUNT_COLORS) {
+         max_colors = maximum_colors;
+      } else if (maximum_colors < MIN_AMOUNT_COLORS) {
+         max_colors = MIN_AMOUNT_COLORS;
+      } else {
+         max_colors = MAX_AMOUNT_COLORS;
+      }
+   }
 };
 
 #endif // PIXEL_HPP
@@ -0,0 +1,465 @@
+/**
+ * @file Reader.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Reader of ppm files.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Parses the header of a ppm file, comments included, and decodes the
+ * pixels straight into the storage of an image.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef READER_HPP
+#define READER_HPP
+
+#include <ctype.h>
+#include <iostream>
+#include <limits>
+#include <stdint.h>
+#include <string>
+#include "Image.hpp"
+
+#define READER_BUFFER_SIZE 65536 /**< Bytes scanned after each read */
+#define MAX_SCANNED_VALUE 65536  /**< Values above it stop growing */
+#define MAX_SCANNED_DIGITS 5     /**< Digits scanned without checks */
+
+/**
+ * @class Reader class.
+ * @brief Reader definition with attributes and methods.
+ *
+ * @details The rows can be read all at once or in several calls, one band
+ * after the other. The #BINARY_TYPE rows are read in a single block per
+ * call, with no per pixel work for 8 bits files with 255 colors. The
+ * #ASCII_TYPE rows are scanned from large blocks of the file by hand,
+ * without the formatted extraction of the streams.
+ */
+class Reader {
+public:
+   /**
+    * @brief Construct a new Reader object for an input stream.
+    *
+    * @param stream Input stream, opened in binary mode.
+    */
+   Reader(std::istream& stream) : input(stream) { }
+
+   /**
+    * @brief Destroy the Reader object.
+    */
+   ~Reader() { }
+
+   /**
+    * @brief Read the header of the file.
+    *
+    * @details The sides are bounded so that the channels of a row, or of a
+    * column once rotated, fit an integer at 16 bits. A file that can seek
+    * must also be long enough for the whole raster, which is checked before
+    * any pixel is allocated.
+    *
+    * @return True if the header is valid or false if it is not.
+    * @see holdsRaster()
+    */
+   bool readHeader() {
+      char magic[2] = { 0, 0 };
+
+      input.read(magic, 2);
+      type = std::string(magic, 2);
+
+      if (!input || (type != ASCII_TYPE && type != BINARY_TYPE)) {
+         return false;
+      }
+
+      if (!readNumber(width) || !readNumber(height) || !readNumber(colors)) {
+         return false;
+      }
+
+      if (width < MIN_WIDTH || height < MIN_HEIGHT || width > MAX_WIDTH ||
+         height > MAX_HEIGHT || colors < MIN_AMOUNT_COLORS ||
+         colors > RGB16::max_colors)
+      {
+         return false;
+      }
+
+      if (type == BINARY_TYPE) {
+         /*
+          * A single whitespace separates the maximum of colors from the
+          * raster.
+          */
+         input.get();
+      }
+
+      return input && holdsRaster();
+   }
+
+   /**
+    * @brief Get the type read in the header.
+    *
+    * @return A string.
+    */
+   std::string getType() const { return type; }
+
+   /**
+    * @brief Get the width read in the header.
+    *
+    * @return An integer.
+    */
+   int getWidth() const { return width; }
+
+   /**
+    * @brief Get the height read in the header.
+    *
+    * @return An integer.
+    */
+   int getHeight() const { return height; }
+
+   /**
+    * @brief Get the maximum of colors read in the header.
+    *
+    * @return An integer.
+    */
+   int getColors() const { return colors; }
+
+   /**
+    * @brief Read the next rows of the file into rows of an image.
+    *
+    * @details The image must have the width and the colors of the header.
+    * Channels above the maximum of colors are clamped to it.
+    *
+    * @param image Image that receives the rows.
+    * @param first_row First row of the image to fill.
+    * @param rows Number of rows to read.
+    * @return True if all rows were read or false if the file ended before.
+    */
+   bool readRows(Image& image, int first_row, int rows) {
+      if (image.isWide()) {
+         return readRows<RGB16>(image, first_row, rows);
+      }
+
+      return readRows<RGB8>(image, first_row, rows);
+   }
+
+   /**
+    * @brief Read a whole image, header and pixels.
+    *
+    * @param[out] image Image that receives the file.
+    * @return True if the file is valid or false if it is not.
+    * @see readHeader()
+    * @see readRows()
+    */
+   bool readImage(Image& image) {
+      if (!readHeader()) {
+         return false;
+      }
+
+      image.setType(type);
+      image.setColors(colors);
+      image.setSize(width, height);
+
+      return readRows(image, 0, height);
+   }
+
+private:
+   std::istream& input;  /**< Input stream */
+   std::string type;     /**< Type read in the header */
+   int width { 0 };      /**< Width read in the header */
+   int height { 0 };     /**< Height read in the header */
+   int colors { 0 };     /**< Maximum of colors read in the header */
+   char block[READER_BUFFER_SIZE]; /**< Block of the raster being scanned */
+   size_t position { 0 };          /**< Next byte to scan in the block */
+   size_t end { 0 };               /**< Bytes read to the block */
+   bool in_comment { false };      /**< Scanning a comment of the raster */
+
+   /**
+    * @brief Read the next rows of the file with a known format.
+    *
+    * @tparam Format #RGB8 or #RGB16.
+    * @param image Image that receives the rows.
+    * @param first_row First row of the image to fill.
+    * @param rows Number of rows to read.
+    * @return True if all rows were read or false if the file ended before.
+    */
+   template <typename Format>
+   bool readRows(Image& image, int first_row, int rows) {
+      if (type == ASCII_TYPE) {
+         return readNumbers<Format>(image, first_row, rows);
+      }
+
+      return readBytes<Format>(image, first_row, rows);
+   }
+
+   /**
+    * @brief Read rows written as bytes.
+    *
+    * @details The rows of the image are contiguous, so the whole block is
+    * read at once into the storage and fixed in place when needed.
+    *
+    * @tparam Format #RGB8 or #RGB16.
+    * @param image Image that receives the rows.
+    * @param first_row First row of the image to fill.
+    * @param rows Number of rows to read.
+    * @return True if all rows were read or false if the file ended before.
+    */
+   template <typename Format>
+   bool readBytes(Image& image, int first_row, int rows) {
+      typedef typename Format::Channel Channel;
+
+      size_t channels { (size_t) image.getStride() * rows };
+      unsigned char* bytes { image.getRowBytes(first_row) };
+      Channel* destination { image.getRow<Format>(first_row) };
+
+      input.read((char*) bytes, channels * sizeof(Channel));
+
+      if ((size_t) input.gcount() != channels * sizeof(Channel)) {
+         return false;
+      }
+
+      if (sizeof(Channel) > 1) {
+         /*
+          * The file keeps the most significant byte first. Each channel is
+          * built from its two bytes before it is overwritten.
+          */
+         for (size_t index { 0 }; index < channels; index++) {
+            destination[index] = (Channel) ((bytes[2 * index] << 8) |
+               bytes[2 * index + 1]);
+         }
+      }
+
+      if (colors < Format::max_colors) {
+         Channel maximum { (Channel) colors };
+
+         for (size_t index { 0 }; index < channels; index++) {
+            if (destination[index] > maximum) {
+               destination[index] = maximum;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   /**
+    * @brief Read rows written as text.
+    *
+    * @details Values above the maximum of colors are clamped to it, like
+    * the colors of a pixel.
+    *
+    * @tparam Format #RGB8 or #RGB16.
+    * @param image Image that receives the rows.
+    * @param first_row First row of the image to fill.
+    * @param rows Number of rows to read.
+    * @return True if all rows were read or false if the file ended before
+    * or has something that is not a number.
+    * @see scanNumber()
+    */
+   template <typename Format>
+   bool readNumbers(Image& image, int first_row, int rows) {
+      typedef typename Format::Channel Channel;
+
+      int channels { image.getWidth() * CHANNELS_PER_PIXEL };
+
+      for (int row { first_row }; row < first_row + rows; row++) {
+         Channel* destination { image.getRow<Format>(row) };
+
+         for (int index { 0 }; index < channels; index++) {
+            int value { 0 };
+
+            if (!scanNumber(value)) {
+               return false;
+            }
+
+            destination[index] = (Channel) (value > colors ? colors : value);
+         }
+      }
+
+      return true;
+   }
+
+   /**
+    * @brief Checks that the rest of the file is long enough for the raster
+    * of the header.
+    *
+    * @details A #BINARY_TYPE raster has the exact size of its channels. A
+    * channel of an #ASCII_TYPE raster has at least a digit and a
+    * whitespace. Streams that can not seek, like pipes, are not checked,
+    * and a short raster is found by readRows() instead.
+    *
+    * @return False if the file is shorter than the raster or true
+    * otherwise.
+    */
+   bool holdsRaster() {
+      std::streampos start { input.tellg() };
+
+      if (start == std::streampos(-1)) {
+         input.clear();
+         return true;
+      }
+
+      input.seekg(0, std::ios::end);
+      std::streampos last { input.tellg() };
+      input.clear();
+      input.seekg(start);
+
+      if (last == std::streampos(-1)) {
+         return true;
+      }
+
+      uint64_t channels { (uint64_t) width * height * CHANNELS_PER_PIXEL };
+      uint64_t bytes { channels * 2 - 1 };
+
+      if (type == BINARY_TYPE) {
+         bytes = colors > RGB8::max_colors ? channels * 2 : channels;
+      }
+
+      return (uint64_t) (last - start) >= bytes;
+   }
+
+   /**
+    * @brief Read the next block of the file to the buffer.
+    *
+    * @return True if some byte was read or false if the file ended.
+    */
+   bool fillBlock() {
+      input.read(block, READER_BUFFER_SIZE);
+      position = 0;
+      end = (size_t) input.gcount();
+
+      return end > 0;
+   }
+
+   /**
+    * @brief Scan the next decimal number of the raster.
+    *
+    * @details Whitespaces and comments before the number are skipped. The
+    * digits are accumulated by hand and the value stops growing after
+    * #MAX_SCANNED_VALUE, so long numbers do not overflow.
+    *
+    * @param[out] value Number scanned.
+    * @return True if a number was scanned or false if the file ended or the
+    * next token is not a number.
+    */
+   bool scanNumber(int& value) {
+      for (;;) {
+         if (position == end && !fillBlock()) {
+            return false;
+         }
+
+         unsigned char character { (unsigned char) block[position] };
+
+         if (in_comment) {
+            in_comment = character != '\n';
+         } else if ((unsigned) (character - '0') <= 9) {
+            break;
+         } else if (character == '#') {
+            in_comment = true;
+         } else if (!isSeparator(character)) {
+            return false;
+         }
+
+         position++;
+      }
+
+      value = 0;
+
+      /*
+       * Far from the end of the block, the digits are scanned without
+       * checking for a new block at each one.
+       */
+      if (end - position > MAX_SCANNED_DIGITS) {
+         char const* cursor { block + position };
+         char const* limit { cursor + MAX_SCANNED_DIGITS };
+         unsigned digit { (unsigned char) *cursor - (unsigned) '0' };
+
+         while (digit <= 9 && cursor < limit) {
+            value = value * 10 + (int) digit;
+            digit = (unsigned char) *++cursor - (unsigned) '0';
+         }
+
+         position = cursor - block;
+
+         if (digit > 9) {
+            return true;
+         }
+      }
+
+      for (;;) {
+         if (position == end && !fillBlock()) {
+            break;
+         }
+
+         unsigned digit { (unsigned char) block[position] - (unsigned) '0' };
+
+         if (digit > 9) {
+            break;
+         }
+
+         if (value <= MAX_SCANNED_VALUE) {
+            value = value * 10 + (int) digit;
+         }
+
+         position++;
+      }
+
+      return true;
+   }
+
+   /**
+    * @brief Checks if a character is a whitespace of the ppm format.
+    *
+    * @param character A character.
+    * @return An boolean.
+    */
+   static bool isSeparator(unsigned char character) {
+      return character == ' ' || (character >= '\t' && character <= '\r');
+   }
+
+   /**
+    * @brief Skip whitespaces and comments until the next token.
+    */
+   void skipSeparators() {
+      int character { input.peek() };
+
+      while (character != EOF) {
+         if (character == '#') {
+            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+         } else if (isspace(character)) {
+            input.get();
+         } else {
+            break;
+         }
+
+         character = input.peek();
+      }
+   }
+
+   /**
+    * @brief Read a non negative decimal number of the header.
+    *
+    * @param[out] number Number read.
+    * @return True if a number was read or false if it was not.
+    */
+   bool readNumber(int& number) {
+      skipSeparators();
+
+      int character { input.peek() };
+
+      if (character == EOF || !isdigit(character)) {
+         return false;
+      }
+
+      number = 0;
+
+      while (character != EOF && isdigit(character)) {
+         if (number > (std::numeric_limits<int>::max() - 9) / 10) {
+            return false;
+         }
+
+         number = number * 10 + (input.get() - '0');
+         character = input.peek();
+      }
+
+      return true;
+   }
+};
+
+#endif // READER_HPP
@@ -0,0 +1,539 @@
+/**
+ * @file Streamer.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Streaming editor of ppm files.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Runs the effects that only need nearby rows on images read and written
+ * in bands, so images larger than the memory can be edited.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef STREAMER_HPP
+#define STREAMER_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <string.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Editor.hpp"
+#include "Reader.hpp"
+#include "Writer.hpp"
+
+#define STREAM_BAND_ROWS 256 /**< Default rows of each band written */
+
+/**
+ * @class Streamer class.
+ * @brief Streamer definition with attributes and methods.
+ *
+ * @details The effects are recorded as stages, with the same methods of
+ * the Editor, and run when the image is written. Each band of the output
+ * asks its stage for the rows it needs from the stage before, with the
+ * halo rows of the masks, down to the file, whose rows are read once and
+ * kept only while a later band needs them. So the memory grows with the
+ * width of the image times the rows of a band, not with its height, and
+ * the output is the same of the Editor.
+ */
+class Streamer {
+public:
+   /**
+    * @brief Construct a new Streamer object for an input stream.
+    *
+    * @param stream Input stream, opened in binary mode.
+    * @param rows Rows of each band written. Values below 1 are taken as 1.
+    */
+   Streamer(std::istream& stream, int rows = STREAM_BAND_ROWS)
+      : reader(stream), band_rows(std::max(rows, 1)) { }
+
+   /**
+    * @brief Destroy the Streamer object.
+    */
+   ~Streamer() { }
+
+   /**
+    * @brief Read the header of the input.
+    *
+    * @return True if the header is valid or false if it is not.
+    * @see Reader::readHeader()
+    */
+   bool readHeader() {
+      if (!reader.readHeader()) {
+         return false;
+      }
+
+      type = reader.getType();
+      width = reader.getWidth();
+      height = reader.getHeight();
+      colors = reader.getColors();
+
+      return true;
+   }
+
+   /**
+    * @brief Get the image width, after the effects recorded.
+    *
+    * @return An integer.
+    */
+   int getWidth() const { return width; }
+
+   /**
+    * @brief Get the image height, after the effects recorded.
+    *
+    * @return An integer.
+    */
+   int getHeight() const { return height; }
+
+   /**
+    * @brief Get the maximum colors per pixel channel.
+    *
+    * @return An integer.
+    */
+   int getColors() const { return colors; }
+
+   /**
+    * @brief Set the threads of the effects run on each band.
+    *
+    * @param number Threads, counting the caller. Values below 1 are taken
+    * as 1.
+    * @see Editor::setThreads()
+    */
+   void setThreads(int number) {
+      editor.setThreads(number);
+   }
+
+   /**
+    * @brief Record a run of point-wise effects.
+    *
+    * @param effects Effects to apply in order.
+    * @see Editor::applyPointEffects()
+    */
+   void applyPointEffects(std::vector<Effects> const& effects) {
+      if (effects.empty()) {
+         return;
+      }
+
+      Stage stage { getStage(Point_Stage) };
+      stage.effects = effects;
+      stages.push_back(std::move(stage));
+   }
+
+   /**
+    * @brief Record a mask of 3 by 3 pixels.
+    *
+    * @param filter Filter to be apply. Accepts "sharpening", "blurring",
+    * "edge-sharpening" and "embossing". Other filters leave the image
+    * unchanged.
+    * @see Editor::applyImageEffects()
+    */
+   void applyImageEffects(std::string filter = "sharpening") {
+      if (filter != "sharpening" && filter != "blurring" &&
+         filter != "edge-sharpening" && filter != "embossing")
+      {
+         return;
+      }
+
+      Stage stage { getStage(Mask_Stage) };
+      stage.filter = filter;
+      stage.halo = 1;
+      stages.push_back(std::move(stage));
+   }
+
+   /**
+    * @brief Record a blur with the mean of a square around each pixel.
+    *
+    * @param radius Pixels from the center to the side of the square. A
+    * radius below 1 leaves the image unchanged.
+    * @see Editor::blurImage()
+    */
+   void blurImage(int radius = 1) {
+      if (radius < 1) {
+         return;
+      }
+
+      Stage stage { getStage(Blur_Stage) };
+      stage.halo = radius;
+      stages.push_back(std::move(stage));
+   }
+
+   /**
+    * @brief Record a reduction of the image to a size.
+    *
+    * @param reduced_width Width of the reduced image, from 1 to the width
+    * of the image.
+    * @param reduced_height Height of the reduced image, from 1 to the
+    * height of the image.
+    * @see Editor::reduceImage(int, int)
+    */
+   void reduceImage(int reduced_width, int reduced_height) {
+      if (reduced_width < 1 || reduced_height < 1 || reduced_width > width ||
+         reduced_height > height)
+      {
+         return;
+      }
+
+      addReduce(getAreasBySize(width, reduced_width),
+         getAreasBySize(height, reduced_height));
+   }
+
+   /**
+    * @brief Record a reduction of the image by a factor.
+    *
+    * @param factor Factor of the reduction, from 1 to the sides of the
+    * image.
+    * @see Editor::reduceImage(double)
+    */
+   void reduceImage(double factor) {
+      if (!(factor >= 1) || factor > width || factor > height) {
+         return;
+      }
+
+      addReduce(getAreasByFactor(width, factor),
+         getAreasByFactor(height, factor));
+   }
+
+   /**
+    * @brief Record an outline around the image.
+    *
+    * @param pixel An Pixel on the border.
+    * @param size Border size.
+    * @param additional_size Additional size for the bottom border.
+    * @see Editor::applyBorder()
+    */
+   void applyBorder(Pixel pixel, int size, int additional_size) {
+      if (pixel.getMaxColors() != colors) {
+         pixel.setColors(colors);
+      }
+
+      Stage stage { getStage(Border_Stage) };
+      stage.pixel = pixel;
+      stage.size = size;
+      stage.additional_size = additional_size;
+      stages.push_back(std::move(stage));
+
+      width += 2 * size;
+      height += 2 * size + additional_size;
+   }
+
+   /**
+    * @brief Convert the output to the other type.
+    *
+    * @param to_type Type to convert. Accepts #ASCII_TYPE, #BINARY_TYPE and
+    * "automatic". Default is "automatic".
+    * @see Editor::convertImage()
+    */
+   void convertImage(std::string to_type = "automatic") {
+      if (to_type == ASCII_TYPE || to_type == BINARY_TYPE) {
+         type = to_type;
+      } else if (to_type == "automatic") {
+         type = type == ASCII_TYPE ? BINARY_TYPE : ASCII_TYPE;
+      }
+   }
+
+   /**
+    * @brief Run the effects recorded and write the image, band by band.
+    *
+    * @param output Output stream.
+    * @return True if the whole input was read or false if it ended before.
+    * @see getRows()
+    */
+   bool writeImage(std::ostream& output) {
+      Writer writer { output };
+      writer.writeHeader(type, width, height, colors);
+
+      window_rows = getInputOverlap();
+
+      for (int first { 0 }; first < height; first += band_rows) {
+         int last { std::min(first + band_rows, height) };
+         Image band { getRows(stages.size(), first, last) };
+
+         writer.writeRows(band, 0, last - first);
+      }
+
+      writer.flush();
+
+      return valid;
+   }
+
+private:
+   /**
+    * @brief Kinds of stages.
+    */
+   enum Stages {
+      Point_Stage,   /**< Point-wise effects, no halo */
+      Mask_Stage,    /**< Mask of 3 by 3 pixels */
+      Blur_Stage,    /**< Blur of any radius */
+      Reduce_Stage,  /**< Reduction by areas */
+      Border_Stage   /**< Outline around the image */
+   };
+
+   /**
+    * @struct Stage struct.
+    * @brief Effect recorded, with the size of the image it receives.
+    */
+   struct Stage {
+      Stages kind;                  /**< Kind of the stage */
+      int width;                    /**< Width of the input */
+      int height;                   /**< Height of the input */
+      int halo { 0 };               /**< Rows needed around each row */
+      std::vector<Effects> effects; /**< Point-wise effects */
+      std::string filter;           /**< Filter of the mask */
+      Areas columns;                /**< Areas of the reduced columns */
+      Areas rows;                   /**< Areas of the reduced rows */
+      Pixel pixel;                  /**< Pixel on the border */
+      int size { 0 };               /**< Border size */
+      int additional_size { 0 };    /**< Additional size for the bottom */
+   };
+
+   Reader reader;               /**< Reader of the input */
+   Editor editor;               /**< Editor of the bands */
+   std::vector<Stage> stages;   /**< Effects recorded, in order */
+   std::string type;            /**< Type of the output */
+   int width { 0 };             /**< Width after the effects recorded */
+   int height { 0 };            /**< Height after the effects recorded */
+   int colors { 0 };            /**< Maximum of colors per pixel channel */
+   int band_rows;               /**< Rows of each band written */
+   Image window;                /**< Last rows read from the input */
+   int window_rows { 0 };       /**< Rows kept in the window, at most */
+   int window_first { 0 };      /**< First row of the input in the window */
+   bool valid { true };         /**< Input read without errors */
+
+   /**
+    * @brief Get a stage for the current size of the image.
+    *
+    * @param kind Kind of the stage.
+    * @return The stage.
+    */
+   Stage getStage(Stages kind) const {
+      Stage stage;
+      stage.kind = kind;
+      stage.width = width;
+      stage.height = height;
+
+      return stage;
+   }
+
+   /**
+    * @brief Record a reduction of the image by areas.
+    *
+    * @param columns Areas of the columns.
+    * @param rows Areas of the rows.
+    */
+   void addReduce(Areas&& columns, Areas&& rows) {
+      Stage stage { getStage(Reduce_Stage) };
+      stage.columns = std::move(columns);
+      stage.rows = std::move(rows);
+
+      width = std::max((int) stage.columns.first.size(), MIN_WIDTH);
+      height = std::max((int) stage.rows.first.size(), MIN_HEIGHT);
+      stages.push_back(std::move(stage));
+   }
+
+   /**
+    * @brief Get the most rows of the input that two consecutive reads may
+    * share.
+    *
+    * @details The bands written share no row. Down the stages, the rows
+    * shared by two requests to a stage grow by its halo on both sides, by
+    * the rows of the boxes of a reduction and the row they may split, and
+    * by the row kept by a border.
+    *
+    * @return A number of rows.
+    */
+   int getInputOverlap() const {
+      int overlap { 0 };
+
+      for (size_t count { stages.size() }; count > 0; count--) {
+         Stage const& stage { stages[count - 1] };
+
+         if (stage.kind == Reduce_Stage) {
+            std::vector<int> const& offsets { stage.rows.offsets };
+            int box { 0 };
+
+            for (size_t position { 1 }; position < offsets.size();
+               position++)
+            {
+               box = std::max(box, offsets[position] - offsets[position - 1]);
+            }
+
+            overlap = overlap * box + 1;
+         } else if (stage.kind == Border_Stage) {
+            overlap += 1;
+         } else {
+            overlap += 2 * stage.halo;
+         }
+      }
+
+      return overlap;
+   }
+
+   /**
+    * @brief Get the rows of the input that a stage needs for some of its
+    * rows.
+    *
+    * @param stage A stage.
+    * @param first First row of the stage output.
+    * @param last Row after the last of the stage output.
+    * @param[out] input_first First row of the input.
+    * @param[out] input_last Row after the last of the input.
+    */
+   static void getInputRows(Stage const& stage, int first, int last,
+      int& input_first, int& input_last)
+   {
+      if (stage.kind == Reduce_Stage) {
+         Areas const& rows { stage.rows };
+
+         input_first = rows.first[first];
+         input_last = rows.first[last - 1] + rows.offsets[last]
+            - rows.offsets[last - 1];
+      } else if (stage.kind == Border_Stage) {
+         /*
+          * A band of the border keeps at least a row of the input, which
+          * is edged like the whole image and cut to the rows of the band.
+          */
+         input_first = std::min(std::max(first - stage.size, 0),
+            stage.height - 1);
+         input_last = std::max(std::min(last - stage.size, stage.height),
+            input_first + 1);
+      } else {
+         input_first = std::max(first - stage.halo, 0);
+         input_last = std::min(last + stage.halo, stage.height);
+      }
+   }
+
+   /**
+    * @brief Get some rows of the output of a stage.
+    *
+    * @details The rows asked to each stage never go back, so the input
+    * is read once. The rows of the stage before are run by the editor as
+    * a whole image, whose edges are the edges of the image only where the
+    * band reaches them, and cut to the rows asked.
+    *
+    * @param count Stages run, 0 for the input.
+    * @param first First row.
+    * @param last Row after the last.
+    * @return An image with the rows.
+    * @see readRows()
+    */
+   Image getRows(size_t count, int first, int last) {
+      if (count == 0) {
+         return readRows(first, last);
+      }
+
+      Stage const& stage { stages[count - 1] };
+      int input_first { 0 };
+      int input_last { 0 };
+
+      /*
+       * A reduction by more than the image leaves a black pixel on the
+       * side with no box, as in the Editor.
+       */
+      if (stage.kind == Reduce_Stage && (stage.columns.first.empty() ||
+         stage.rows.first.empty()))
+      {
+         return Image { reader.getType(),
+            (int) stage.columns.first.size(), last - first, colors };
+      }
+
+      getInputRows(stage, first, last, input_first, input_last);
+      editor.setImage(getRows(count - 1, input_first, input_last));
+
+      switch (stage.kind) {
+         case Point_Stage:
+            editor.applyPointEffects(stage.effects);
+            break;
+         case Mask_Stage:
+            editor.applyImageEffects(stage.filter);
+            break;
+         case Blur_Stage:
+            editor.blurImage(stage.halo);
+            break;
+         case Reduce_Stage:
+            editor.reduceAreas(stage.columns,
+               getAreasSlice(stage.rows, first, last));
+            input_first = first;
+            break;
+         case Border_Stage:
+            editor.applyBorder(stage.pixel, stage.size,
+               stage.additional_size);
+            break;
+      }
+
+      return cutRows(editor.releaseImage(), first - input_first,
+         last - first);
+   }
+
+   /**
+    * @brief Read some rows of the input.
+    *
+    * @details The rows kept in the window are copied and only the rows
+    * after it are read from the input. Then the window keeps only the last
+    * rows that the next read may share, instead of a copy of the whole
+    * band.
+    *
+    * @param first First row, not before the first of the window.
+    * @param last Row after the last.
+    * @return An image with the rows.
+    */
+   Image readRows(int first, int last) {
+      Image rows { reader.getType(), reader.getWidth(), last - first,
+         reader.getColors() };
+      int window_last { window_first + window.getHeight() };
+      int kept { std::max(std::min(last, window_last) - first, 0) };
+
+      assert(kept == 0 || first >= window_first);
+
+      if (kept > 0) {
+         memcpy(rows.getRowBytes(0), window.getRowBytes(first - window_first),
+            rows.getRowSize() * kept);
+      }
+
+      if (kept < last - first &&
+         !reader.readRows(rows, kept, last - first - kept))
+      {
+         valid = false;
+      }
+
+      int shared { std::min(window_rows, last - first) };
+
+      window = Image { };
+      window_first = last - shared;
+
+      if (shared > 0) {
+         window = Image { reader.getType(), reader.getWidth(), shared,
+            reader.getColors() };
+
+         memcpy(window.getRowBytes(0), rows.getRowBytes(last - first - shared),
+            rows.getRowSize() * shared);
+      }
+
+      return rows;
+   }
+
+   /**
+    * @brief Cut some consecutive rows of an image.
+    *
+    * @param image An image.
+    * @param first First row to keep.
+    * @param rows Rows to keep.
+    * @return The image with only the rows kept.
+    */
+   static Image cutRows(Image&& image, int first, int rows) {
+      if (first == 0 && rows == image.getHeight()) {
+         return std::move(image);
+      }
+
+      Image cut { image.getType(), image.getWidth(), rows,
+         image.getColors() };
+
+      memcpy(cut.getRowBytes(0), image.getRowBytes(first),
+         image.getRowSize() * rows);
+
+      return cut;
+   }
+};
+
+#endif // STREAMER_HPP
@@ -0,0 +1,189 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Thread pool setting.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Defines a pool of threads that run the tasks of a job together, used to
+ * split the work of the editor between the cores of the machine.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool class.
+ * @brief Thread pool definition with attributes and methods.
+ *
+ * @details The threads are created with the pool and wait for jobs until
+ * it is destroyed. A job is a number of tasks taken in any order by the
+ * threads and by the caller, which waits for all of them to finish.
+ */
+class ThreadPool {
+public:
+   /**
+    * @brief Construct a new ThreadPool object.
+    *
+    * @param threads Threads of the jobs, counting the caller. Values below
+    * 1 are taken as 1.
+    */
+   ThreadPool(int threads) {
+      for (int thread { 1 }; thread < threads; thread++) {
+         workers.emplace_back(&ThreadPool::waitJobs, this);
+      }
+   }
+
+   ThreadPool(ThreadPool const&) = delete;
+   ThreadPool& operator=(ThreadPool const&) = delete;
+
+   /**
+    * @brief Destroy the ThreadPool object after its threads finish.
+    */
+   ~ThreadPool() {
+      {
+         std::lock_guard<std::mutex> lock { mutex };
+         stopping = true;
+      }
+
+      wake.notify_all();
+
+      for (std::thread& worker : workers) {
+         worker.join();
+      }
+   }
+
+   /**
+    * @brief Get the threads of the jobs.
+    *
+    * @return An integer, counting the caller.
+    */
+   int getThreads() const {
+      return (int) workers.size() + 1;
+   }
+
+   /**
+    * @brief Get the default threads of the jobs.
+    *
+    * @return The hardware threads of the machine, or 1 when unknown.
+    */
+   static int getDefaultThreads() {
+      return std::max((int) std::thread::hardware_concurrency(), 1);
+   }
+
+   /**
+    * @brief Run the tasks of a job and wait for all of them.
+    *
+    * @param tasks Number of tasks.
+    * @param task Function called once with the index of each task.
+    */
+   void run(int tasks, std::function<void(int)> const& task) {
+      if (workers.empty() || tasks < 2) {
+         for (int index { 0 }; index < tasks; index++) {
+            task(index);
+         }
+
+         return;
+      }
+
+      {
+         std::unique_lock<std::mutex> lock { mutex };
+
+         /*
+          * Threads still leaving the last job would take tasks of this one.
+          */
+         done.wait(lock, [this] () { return active == 0; });
+
+         job = &task;
+         job_tasks = tasks;
+         next_task = 0;
+         pending_tasks = tasks;
+         generation++;
+      }
+
+      wake.notify_all();
+      runTasks(&task, tasks);
+
+      std::unique_lock<std::mutex> lock { mutex };
+      done.wait(lock, [this] () { return pending_tasks == 0; });
+   }
+
+private:
+   std::vector<std::thread> workers;               /**< Threads of the pool */
+   std::mutex mutex;                               /**< Guard of the job */
+   std::condition_variable wake;                   /**< Signal of new jobs */
+   std::condition_variable done;                   /**< Signal of finishes */
+   std::function<void(int)> const* job { nullptr }; /**< Current job */
+   int job_tasks { 0 };                            /**< Tasks of the job */
+   std::atomic<int> next_task { 0 };               /**< Next task to take */
+   std::atomic<int> pending_tasks { 0 };           /**< Tasks not finished */
+   unsigned generation { 0 };                      /**< Jobs started */
+   int active { 0 };                               /**< Threads in a job */
+   bool stopping { false };                        /**< Pool destruction */
+
+   /**
+    * @brief Take and run tasks of a job until none is left.
+    *
+    * @param task Function of the job.
+    * @param tasks Number of tasks of the job.
+    */
+   void runTasks(std::function<void(int)> const* task, int tasks) {
+      for (int index { next_task++ }; index < tasks; index = next_task++) {
+         (*task)(index);
+
+         if (--pending_tasks == 0) {
+            std::lock_guard<std::mutex> lock { mutex };
+            done.notify_all();
+         }
+      }
+   }
+
+   /**
+    * @brief Wait for jobs and help to run them until the pool is destroyed.
+    */
+   void waitJobs() {
+      unsigned seen { 0 };
+
+      while (true) {
+         std::function<void(int)> const* task { nullptr };
+         int tasks { 0 };
+
+         {
+            std::unique_lock<std::mutex> lock { mutex };
+            wake.wait(lock, [&] () {
+               return stopping || generation != seen;
+            });
+
+            if (stopping) {
+               return;
+            }
+
+            seen = generation;
+            task = job;
+            tasks = job_tasks;
+            active++;
+         }
+
+         runTasks(task, tasks);
+
+         {
+            std::lock_guard<std::mutex> lock { mutex };
+            active--;
+         }
+
+         done.notify_all();
+      }
+   }
+};
+
+#endif // THREAD_POOL_HPP
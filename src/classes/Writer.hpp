@@ -0,0 +1,293 @@
+/**
+ * @file Writer.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Streaming writer of ppm files.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Formats the header and the pixels of an image straight into an output
+ * stream through a fixed-size buffer, without building the whole file in
+ * memory.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef WRITER_HPP
+#define WRITER_HPP
+
+#include <iostream>
+#include <string>
+#include "Image.hpp"
+
+#define WRITER_BUFFER_SIZE 65536 /**< Bytes formatted before each write */
+#define MAX_PIXEL_CHARACTERS 18  /**< Characters of "65535 65535 65535 " */
+
+/**
+ * @class Writer class.
+ * @brief Writer definition with attributes and methods.
+ *
+ * @details The rows can be written all at once or in several calls, one
+ * band after the other. The lines of #ASCII_TYPE files are broken before
+ * they pass #MAX_COLUMNS_PER_LINE columns, even between two rows.
+ */
+class Writer {
+public:
+   /**
+    * @brief Construct a new Writer object for an output stream.
+    *
+    * @param stream Output stream.
+    */
+   Writer(std::ostream& stream) : output(stream) { }
+
+   /**
+    * @brief Destroy the Writer object.
+    * @see flush()
+    */
+   ~Writer() {
+      flush();
+   }
+
+   /**
+    * @brief Write the header of the file.
+    *
+    * @param type Image type.
+    * @param width Image width.
+    * @param height Image height.
+    * @param colors Maximum of colors per pixel channel.
+    */
+   void writeHeader(std::string type, int width, int height, int colors) {
+      ascii = type != BINARY_TYPE;
+      line_size = 0;
+
+      std::string header { getHeader(type, width, height, colors) };
+      append(header.c_str(), header.size());
+   }
+
+   /**
+    * @brief Get the header of a file.
+    *
+    * @param type Image type.
+    * @param width Image width.
+    * @param height Image height.
+    * @param colors Maximum of colors per pixel channel.
+    * @return A string.
+    */
+   static std::string getHeader(std::string type, int width, int height,
+      int colors)
+   {
+      std::string header { type + "\n" };
+      header += std::to_string(width) + " " + std::to_string(height) + "\n";
+      header += std::to_string(colors) + "\n";
+
+      return header;
+   }
+
+   /**
+    * @brief Copy some rows of an image as the bytes of a #BINARY_TYPE file.
+    *
+    * @details The bytes of a row have the size of the row in the image, so
+    * the rows of the file can be filled in any order.
+    *
+    * @param image Image with the rows.
+    * @param first_row First row to copy.
+    * @param rows Number of rows to copy.
+    * @param[out] destination First byte of the first row.
+    * @see Image::getRowSize()
+    */
+   static void copyBytes(Image const& image, int first_row, int rows,
+      unsigned char* destination)
+   {
+      size_t channels { (size_t) image.getStride() * rows };
+
+      if (!image.isWide()) {
+         memcpy(destination, image.getRowBytes(first_row), channels);
+         return;
+      }
+
+      RGB16::Channel const* source { image.getRow<RGB16>(first_row) };
+
+      for (size_t index { 0 }; index < channels; index++) {
+         destination[2 * index] = (unsigned char) (source[index] >> 8);
+         destination[2 * index + 1] = (unsigned char) (source[index] & 0xFF);
+      }
+   }
+
+   /**
+    * @brief Write some rows of an image, after the header.
+    *
+    * @param image Image with the rows.
+    * @param first_row First row to write.
+    * @param rows Number of rows to write.
+    */
+   void writeRows(Image const& image, int first_row, int rows) {
+      if (image.isWide()) {
+         writeRows<RGB16>(image, first_row, rows);
+      } else {
+         writeRows<RGB8>(image, first_row, rows);
+      }
+   }
+
+   /**
+    * @brief Write a whole image, header and pixels.
+    *
+    * @param image Image to write.
+    * @see writeHeader()
+    * @see writeRows()
+    * @see flush()
+    */
+   void writeImage(Image const& image) {
+      writeHeader(image.getType(), image.getWidth(), image.getHeight(),
+         image.getColors());
+      writeRows(image, 0, image.getHeight());
+      flush();
+   }
+
+   /**
+    * @brief Send the formatted bytes to the output stream.
+    */
+   void flush() {
+      if (used > 0) {
+         output.write(buffer, used);
+         used = 0;
+      }
+   }
+
+private:
+   std::ostream& output;              /**< Output stream */
+   char buffer[WRITER_BUFFER_SIZE];   /**< Formatted bytes */
+   size_t used { 0 };                 /**< Bytes used in the buffer */
+   size_t line_size { 0 };            /**< Columns of the current line */
+   bool ascii { true };               /**< Writes numbers instead of bytes */
+
+   /**
+    * @brief Write some rows of an image with a known format.
+    *
+    * @tparam Format #RGB8 or #RGB16.
+    * @param image Image with the rows.
+    * @param first_row First row to write.
+    * @param rows Number of rows to write.
+    */
+   template <typename Format>
+   void writeRows(Image const& image, int first_row, int rows) {
+      int channels { image.getWidth() * CHANNELS_PER_PIXEL };
+
+      for (int row { first_row }; row < first_row + rows; row++) {
+         typename Format::Channel const* source {
+            image.getRow<Format>(row)
+         };
+
+         if (ascii) {
+            writeNumbers(source, channels);
+         } else {
+            writeBytes(source, channels);
+         }
+      }
+   }
+
+   /**
+    * @brief Write channels as text, breaking the lines between pixels.
+    *
+    * @tparam Channel Type of a single channel.
+    * @param source First channel.
+    * @param channels Number of channels.
+    */
+   template <typename Channel>
+   void writeNumbers(Channel const* source, int channels) {
+      char pixel[MAX_PIXEL_CHARACTERS];
+
+      for (int index { 0 }; index < channels; index += CHANNELS_PER_PIXEL) {
+         size_t size { 0 };
+
+         size += formatNumber(source[index], pixel + size);
+         pixel[size++] = ' ';
+         size += formatNumber(source[index + 1], pixel + size);
+         pixel[size++] = ' ';
+         size += formatNumber(source[index + 2], pixel + size);
+         pixel[size++] = ' ';
+
+         if (line_size + size > MAX_COLUMNS_PER_LINE) {
+            append("\n", 1);
+            line_size = 0;
+         }
+
+         append(pixel, size);
+         line_size += size;
+      }
+   }
+
+   /**
+    * @brief Write 8 bits channels as bytes.
+    *
+    * @details The channels are already the bytes of the file, so the row
+    * goes straight to the stream.
+    *
+    * @param source First channel.
+    * @param channels Number of channels.
+    */
+   void writeBytes(RGB8::Channel const* source, int channels) {
+      flush();
+      output.write((char const*) source, channels);
+   }
+
+   /**
+    * @brief Write 16 bits channels as two bytes, most significant first.
+    *
+    * @param source First channel.
+    * @param channels Number of channels.
+    */
+   void writeBytes(RGB16::Channel const* source, int channels) {
+      for (int index { 0 }; index < channels; index++) {
+         char bytes[2] = {
+            (char) (source[index] >> 8),
+            (char) (source[index] & 0xFF)
+         };
+
+         append(bytes, 2);
+      }
+   }
+
+   /**
+    * @brief Write the decimal digits of a number.
+    *
+    * @param number A non negative number.
+    * @param[out] destination Position of the first digit.
+    * @return Number of digits.
+    */
+   static size_t formatNumber(unsigned number, char* destination) {
+      char digits[10];
+      size_t size { 0 };
+
+      do {
+         digits[size++] = (char) ('0' + number % 10);
+         number /= 10;
+      } while (number != 0);
+
+      for (size_t index { 0 }; index < size; index++) {
+         destination[index] = digits[size - index - 1];
+      }
+
+      return size;
+   }
+
+   /**
+    * @brief Copy bytes to the buffer, flushing it when it is full.
+    *
+    * @param bytes Bytes to copy.
+    * @param size Number of bytes.
+    */
+   void append(char const* bytes, size_t size) {
+      if (used + size > WRITER_BUFFER_SIZE) {
+         flush();
+      }
+
+      if (size > WRITER_BUFFER_SIZE) {
+         output.write(bytes, size);
+         return;
+      }
+
+      memcpy(buffer + used, bytes, size);
+      used += size;
+   }
+};
+
+#endif // WRITER_HPP
@@ -6,7 +6,8 @@
  * @date 2023-07-18
  * 
  * Definition of default fonts and functions to pick up a font and/or an 
- * emoji by name.
+ * emoji by name. Each font is read the first time it is picked up, so the
+ * runs that write no text read no font.
  * 
  * @copyright Copyright (c) 2023
  */
@@ -18,34 +19,72 @@
 #include "Font.hpp"
 
 /**
- * @brief Global Highlander font.
+ * @brief Get the global Highlander font.
+ *
+ * @details The font is a local static, read once by the first call even
+ * when many threads call it together.
+ *
+ * @return An global font.
  */
-Font const HIGHLANDER { "assets/fonts/highlander_std.bdf" };
+Font const& getHighlanderFont() {
+   static Font const font { "assets/fonts/highlander_std.bdf" };
+   return font;
+}
 
 /**
- * @brief Global IBM Bios 16x16 font.
+ * @brief Get the global IBM Bios 16x16 font.
+ *
+ * @return An global font.
+ * @see getHighlanderFont()
  */
-Font const IBM_BIOS { "assets/fonts/ib16x16u.bdf" };
+Font const& getIBMBiosFont() {
+   static Font const font { "assets/fonts/ib16x16u.bdf" };
+   return font;
+}
 
 /**
- * @brief Global Satisfy font.
+ * @brief Get the global Satisfy font.
+ *
+ * @return An global font.
+ * @see getHighlanderFont()
  */
-Font const SATISFY { "assets/fonts/satisfy16.bdf" };
+Font const& getSatisfyFont() {
+   static Font const font { "assets/fonts/satisfy16.bdf" };
+   return font;
+}
 
 /**
- * @brief Global DS Net Child font.
+ * @brief Get the global DS Net Child font.
+ *
+ * @return An global font.
+ * @see getHighlanderFont()
  */
-Font const NETCHILD { "assets/fonts/DSnetChild.bdf" };
+Font const& getNetChildFont() {
+   static Font const font { "assets/fonts/DSnetChild.bdf" };
+   return font;
+}
 
 /**
- * @brief Global Love Script font.
+ * @brief Get the global Love Script font.
+ *
+ * @return An global font.
+ * @see getHighlanderFont()
  */
-Font const LOVESCRIPT { "assets/fonts/LoveScript.bdf" };
+Font const& getLoveScriptFont() {
+   static Font const font { "assets/fonts/LoveScript.bdf" };
+   return font;
+}
 
 /**
- * @brief Global Pixel Icons Compilation font.
+ * @brief Get the global Pixel Icons Compilation font.
+ *
+ * @return An global font.
+ * @see getHighlanderFont()
  */
-Font const PIXELICONS { "assets/fonts/PixelIconsCompilation.bdf" };
+Font const& getPixelIconsFont() {
+   static Font const font { "assets/fonts/PixelIconsCompilation.bdf" };
+   return font;
+}
 
 /**
  * @brief Get the global font by font name.
@@ -55,16 +94,16 @@ Font const PIXELICONS { "assets/fonts/PixelIconsCompilation.bdf" };
  */
 Font const& getFontByName(std::string font_name) {
    if (font_name == "highlander") {
-      return HIGHLANDER;
+      return getHighlanderFont();
    } else if (font_name == "satisfy") {
-      return SATISFY;
+      return getSatisfyFont();
    } else if (font_name == "netchild") {
-      return NETCHILD;
+      return getNetChildFont();
    } else if (font_name == "love") {
-      return LOVESCRIPT;
+      return getLoveScriptFont();
    }
 
-   return IBM_BIOS;
+   return getIBMBiosFont();
 }
 
 /**
@@ -198,7 +237,7 @@ Glyph const* getEmojiByCode(std::string emoji_code) {
       encoding = 'A'; //* Skull pixel icon.
    }
 
-   return PIXELICONS.getGlyph(encoding);
+   return getPixelIconsFont().getGlyph(encoding);
 }
 
 #endif // FONTS_HPP
@@ -12,6 +12,7 @@
  */
 
 #include <iostream>
+#include <utility>
 #include "Manipulator.hpp"
 
 using namespace std;
@@ -45,9 +46,18 @@ int main(int argc, char* argv[]) {
       return 0;
    }
 
+   if (searchString(argc, argv, "--batch") != -1) {
+      return batchImages(argc, argv) ? 0 : 1;
+   }
+
+   if (searchString(argc, argv, "--stream") != -1) {
+      return streamImage(argc, argv) ? 0 : 1;
+   }
+
    int images { getInputFiles(main_image, second_image, argc, argv) };
 
-   Editor editor { main_image };
+   Editor editor { std::move(main_image) };
+   getThreadsNumber(editor, argc, argv);
 
    if (images == 2) {
       getCombineFunction(editor, second_image, argc, argv);
@@ -15,6 +15,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <stdio.h>
 #include "Manipulator.hpp"
 #include "Editor.hpp"
 
@@ -66,14 +68,23 @@ public:
     * 
     * @param expected_image Expected image in the test.
     * @param effect Effect used in the test.
+    * @param threads Threads of the editor.
     */
-   void testEffect(std::string expected_image, Effects effect) {
+   void testEffect(std::string expected_image, Effects effect,
+      int threads = 1)
+   {
       Editor editor { image };
       bool passed { false };
 
       Image expected;
       openImage(expected_image, expected);
 
+      editor.setThreads(threads);
+
+      if (threads > 1) {
+         std::cout << threads << " threads, ";
+      }
+
       switch(effect) {
          case Blurring:
             std::cout << "Blurring:\n\t";
@@ -95,6 +106,11 @@ public:
             editor.enlargeImage();
             passed = editor.getImage() == expected;
             break;
+         case Flip:
+            std::cout << "Flip:\n\t";
+            editor.rotateImage("flip");
+            passed = editor.getImage() == expected;
+            break;
          case Gray:
             std::cout << "Grayscale:\n\t";
             editor.grayscaleImage();
@@ -115,6 +131,11 @@ public:
             editor.reduceImage();
             passed = editor.getImage() == expected;
             break;
+         case Rotate_Half:
+            std::cout << "Rotate Half:\n\t";
+            editor.rotateImage("half");
+            passed = editor.getImage() == expected;
+            break;
          case Rotate_Left:
             std::cout << "Rotate Left:\n\t";
             editor.rotateImage("left");
@@ -144,6 +165,530 @@ public:
       tests++;
    }
 
+   /**
+    * @brief Runs the blur with a radius and checks for equality with
+    * expectation.
+    * 
+    * @param expected_image Expected image in the test.
+    * @param radius Radius of the blur.
+    * @param threads Threads of the editor.
+    */
+   void testBlur(std::string expected_image, int radius, int threads = 1) {
+      Editor editor { image };
+      Image expected;
+
+      openImage(expected_image, expected);
+      editor.setThreads(threads);
+
+      if (threads > 1) {
+         std::cout << threads << " threads, ";
+      }
+
+      std::cout << "Blurring (radius " << radius << "):\n\t";
+      editor.blurImage(radius);
+
+      if (editor.getImage() == expected) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs a chain of point-wise effects in a single pass and checks
+    * for equality with expectation.
+    * 
+    * @param expected_image Expected image in the test.
+    * @param effects Effects in the order to apply.
+    */
+   void testPointEffects(std::string expected_image,
+      std::vector<Effects> effects)
+   {
+      Editor editor { image };
+      Image expected;
+
+      openImage(expected_image, expected);
+
+      std::cout << "Point effects:\n\t";
+      editor.applyPointEffects(effects);
+
+      if (editor.getImage() == expected) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs a chain of rotations and mirrors in a single pass and
+    * checks for equality with expectation.
+    * 
+    * @param expected_image Expected image in the test.
+    * @param effects Effects in the order to apply.
+    */
+   void testGeometricEffects(std::string expected_image,
+      std::vector<Effects> effects)
+   {
+      Editor editor { image };
+      Image expected;
+
+      openImage(expected_image, expected);
+
+      std::cout << "Geometric effects:\n\t";
+      editor.applyGeometricEffects(effects);
+
+      if (editor.getImage() == expected) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs the resize and checks for equality with expectation.
+    * 
+    * @param expected_image Expected image in the test.
+    * @param width Width of the resized image.
+    * @param height Height of the resized image.
+    * @param filter Resampling filter.
+    * @param threads Threads of the editor. Default is 1.
+    */
+   void testResize(std::string expected_image, int width, int height,
+      Filters filter, int threads = 1)
+   {
+      Editor editor { image };
+      Image expected;
+
+      openImage(expected_image, expected);
+      editor.setThreads(threads);
+
+      if (threads > 1) {
+         std::cout << threads << " threads, ";
+      }
+
+      std::cout << "Resize (" << width << "x" << height << ", "
+         << (filter == Nearest ? "nearest" : filter == Bilinear ?
+         "bilinear" : "bicubic") << "):\n\t";
+      editor.resizeImage(width, height, filter);
+
+      if (editor.getImage() == expected) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs the reduction by a factor and checks for equality with
+    * expectation.
+    * 
+    * @param expected_image Expected image in the test.
+    * @param factor Factor of the reduction.
+    * @param threads Threads of the editor. Default is 1.
+    */
+   void testReduce(std::string expected_image, double factor,
+      int threads = 1)
+   {
+      Editor editor { image };
+      Image expected;
+
+      openImage(expected_image, expected);
+      editor.setThreads(threads);
+
+      if (threads > 1) {
+         std::cout << threads << " threads, ";
+      }
+
+      std::cout << "Reduce (factor " << factor << "):\n\t";
+      editor.reduceImage(factor);
+
+      if (editor.getImage() == expected) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs the reduction to a size and checks for equality with
+    * expectation.
+    * 
+    * @param expected_image Expected image in the test.
+    * @param width Width of the reduced image.
+    * @param height Height of the reduced image.
+    */
+   void testReduceSize(std::string expected_image, int width, int height) {
+      Editor editor { image };
+      Image expected;
+
+      openImage(expected_image, expected);
+
+      std::cout << "Reduce (" << width << "x" << height << "):\n\t";
+      editor.reduceImage(width, height);
+
+      if (editor.getImage() == expected) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Rescales the colors of the image and checks for equality with
+    * the rescale of each pixel.
+    * 
+    * @param colors Colors of the rescaled image.
+    */
+   void testRescale(int colors) {
+      Image rescaled { image };
+      rescaled.rescaleColors(colors);
+
+      bool equal { rescaled.getColors() == colors };
+
+      for (int row { 0 }; equal && row < image.getHeight(); row++) {
+         for (int column { 0 }; column < image.getWidth(); column++) {
+            Pixel expected { image.getPixel(row, column) };
+            expected.setColors(colors);
+
+            Pixel pixel { rescaled.getPixel(row, column) };
+
+            if (pixel.getRed() != expected.getRed() ||
+               pixel.getGreen() != expected.getGreen() ||
+               pixel.getBlue() != expected.getBlue())
+            {
+               equal = false;
+               break;
+            }
+         }
+      }
+
+      std::cout << "Rescale (" << colors << " colors):\n\t";
+
+      if (equal) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Streams the image in bands through masks, a reduction and a
+    * border, and checks for equality with the editor.
+    * 
+    * @param rows Rows of each band.
+    */
+   void testStream(int rows) {
+      std::stringstream input;
+      writePPM(input, image);
+
+      Streamer streamer { input, rows };
+      Editor editor { image };
+      Pixel white { getColorByName("white") };
+
+      streamer.readHeader();
+      streamer.applyImageEffects("sharpening");
+      streamer.blurImage(3);
+      streamer.applyPointEffects({ Negative });
+      streamer.reduceImage(1.5);
+      streamer.applyBorder(white, 4, 8);
+
+      editor.applyImageEffects("sharpening");
+      editor.blurImage(3);
+      editor.applyPointEffects({ Negative });
+      editor.reduceImage(1.5);
+      editor.applyBorder(white, 4, 8);
+
+      std::stringstream output;
+      Image streamed;
+      Reader reader { output };
+
+      bool equal { streamer.writeImage(output) &&
+         reader.readImage(streamed) && streamed == editor.getImage() };
+
+      std::cout << "Stream (" << rows << " rows):\n\t";
+
+      if (equal) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Writes the image with a type and colors and checks that the
+    * reader gives it back.
+    * 
+    * @param type Type of the written image.
+    * @param colors Colors of the written image.
+    */
+   void testRoundTrip(std::string type, int colors) {
+      Image written { image };
+      written.setType(type);
+      written.rescaleColors(colors);
+
+      std::stringstream stream;
+      writePPM(stream, written);
+
+      Image read;
+      Reader reader { stream };
+
+      std::cout << "Round trip (" << type << ", " << colors
+         << " colors):\n\t";
+
+      if (reader.readImage(read) && read == written) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Reads a file and writes it again, and checks that the bytes
+    * written are the bytes of the file.
+    * 
+    * @param local File location.
+    */
+   void testFile(std::string local) {
+      std::ifstream file(local, std::ios::binary);
+      std::stringstream contents;
+      contents << file.rdbuf();
+
+      std::stringstream stream { contents.str() };
+      std::stringstream written;
+      Image read;
+      Reader reader { stream };
+      bool passed { reader.readImage(read) };
+
+      if (passed) {
+         writePPM(written, read);
+         written << '\n';
+         passed = written.str() == contents.str();
+      }
+
+      std::cout << "File (" << local << "):\n\t";
+
+      if (passed) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Writes the image to a file mapped to memory and checks that
+    * the file is read back as the image.
+    * 
+    * @param local File location.
+    * @param colors Colors of the written image.
+    */
+   void testMapped(std::string local, int colors) {
+      Image written { image };
+      written.rescaleColors(colors);
+
+      Editor editor { std::move(written) };
+      editor.setThreads(4);
+
+      Image read;
+      bool passed { exportMapped(local, editor) && readImage(local, read) &&
+         read == editor.getImage() };
+
+      remove(local.c_str());
+
+      std::cout << "Mapped file (" << colors << " colors):\n\t";
+
+      if (passed) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs a batch over a valid and a bad input and checks that only
+    * the valid one is written, as expected.
+    * 
+    * @param input Valid input file.
+    * @param bad_input Input file that can not be read.
+    * @param effect Effect of the batch.
+    * @param expected_image Expected image of the valid input.
+    */
+   void testBatch(std::string input, std::string bad_input,
+      std::string effect, std::string expected_image)
+   {
+      std::string output { "bin/batch-%.ppm" };
+      std::vector<std::string> arguments { "main", "--batch", "-i", input,
+         bad_input, "-e", effect, "-o", output };
+      std::vector<char*> argv;
+
+      for (std::string& argument : arguments) {
+         argv.push_back(&argument[0]);
+      }
+
+      std::string written { getBatchOutput(output, input) };
+      std::string bad_written { getBatchOutput(output, bad_input) };
+      Image read;
+      Image expected;
+
+      openImage(expected_image, expected);
+
+      bool passed { !batchImages((int) argv.size(), argv.data()) &&
+         readImage(written, read) && read == expected &&
+         !std::ifstream(bad_written).is_open() };
+
+      remove(written.c_str());
+      remove(bad_written.c_str());
+
+      std::cout << "Batch (" << effect << "):\n\t";
+
+      if (passed) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Runs a batch with an option that is not valid and checks that
+    * the image is not written, as expected.
+    * 
+    * @param input Input file.
+    * @param options Effect and its options.
+    */
+   void testBatchOption(std::string input, std::vector<std::string> options)
+   {
+      std::string output { "bin/batch-%.ppm" };
+      std::vector<std::string> arguments { "main", "--batch", "-i", input,
+         "-e" };
+      std::vector<char*> argv;
+
+      arguments.insert(arguments.end(), options.begin(), options.end());
+      arguments.push_back("-o");
+      arguments.push_back(output);
+
+      for (std::string& argument : arguments) {
+         argv.push_back(&argument[0]);
+      }
+
+      std::string written { getBatchOutput(output, input) };
+      bool passed { !batchImages((int) argv.size(), argv.data()) &&
+         !std::ifstream(written).is_open() };
+
+      remove(written.c_str());
+
+      std::cout << "Batch (";
+
+      for (std::string const& option : options) {
+         std::cout << (option == options.front() ? "" : " ") << option;
+      }
+
+      std::cout << "):\n\t";
+
+      if (passed) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Reads a file and checks that it is valid or not, as expected.
+    * 
+    * @param label Name of the test.
+    * @param text Contents of the file.
+    * @param valid Whether the file is valid.
+    */
+   void testRead(std::string label, std::string text, bool valid) {
+      std::stringstream stream { text };
+      Image read;
+      Reader reader { stream };
+
+      std::cout << label << ":\n\t";
+
+      if (reader.readImage(read) == valid) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
+   /**
+    * @brief Reads a file of a single pixel and checks its colors.
+    * 
+    * @param label Name of the test.
+    * @param text Contents of the file.
+    * @param red Expected red.
+    * @param green Expected green.
+    * @param blue Expected blue.
+    */
+   void testReadPixel(std::string label, std::string text, int red,
+      int green, int blue)
+   {
+      std::stringstream stream { text };
+      Image read;
+      Reader reader { stream };
+      bool passed { reader.readImage(read) };
+
+      if (passed) {
+         Pixel pixel { read.getPixel(0, 0) };
+
+         passed = pixel.getRed() == red && pixel.getGreen() == green &&
+            pixel.getBlue() == blue;
+      }
+
+      std::cout << label << ":\n\t";
+
+      if (passed) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
    /**
     * @brief Runs the method and checks for equality with expectation.
     * 
@@ -177,6 +722,35 @@ public:
       tests++;
    }
 
+   /**
+    * @brief Looks up every encoding of 16 bits in a font and checks that a
+    * glyph is always found, of the same encoding when the font has one.
+    * 
+    * @param font_name Font name.
+    */
+   void testGlyphs(std::string font_name) {
+      Font const& font { getFontByName(font_name) };
+      bool found { true };
+
+      for (int encoding { -1 }; found && encoding <= 0xFFFF; encoding++) {
+         Glyph const* glyph { font.getGlyph(encoding) };
+
+         found = glyph != nullptr && (!font.hasGlyph(encoding) ||
+            glyph->getEncoding() == encoding);
+      }
+
+      std::cout << "Glyphs (" << font_name << "):\n\t";
+
+      if (found) {
+         std::cout << "✔ Test success!" << std::endl;
+         success_tests++;
+      } else {
+         std::cout << "✕ Test error!" << std::endl;
+      }
+
+      tests++;
+   }
+
    /**
     * @brief Runs the method and checks for equality with expectation.
     * 
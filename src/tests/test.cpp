@@ -7,24 +7,87 @@ int main() {
 
    flowers.testCombine("assets/imgs/combine.ppm", 
       "assets/imgs/bill.ppm", 0, 0);
+   flowers.testRescale(65535);
+   flowers.testRescale(100);
+
+   cout << "\nReader:\n";
+   galinhos.testRoundTrip(ASCII_TYPE, 255);
+   flowers.testRoundTrip(ASCII_TYPE, 65535);
+   galinhos.testReadPixel("Glued comments", "P3 1 1 255\n1#c\n2 #c\n3", 1,
+      2, 3);
+   galinhos.testReadPixel("Clamped values", "P3 1 1 100\n200 100 70000",
+      100, 100, 100);
+   galinhos.testRead("Bad token", "P3 1 1 255\n1 x 3", false);
+   galinhos.testRead("Truncated raster", "P3 2 1 255\n1 2 3 4 5", false);
+   galinhos.testRead("Short text raster", "P3 100000 100000 255\n1 2 3",
+      false);
+   galinhos.testFile("assets/imgs/wide.ppm");
+   galinhos.testReadPixel("Wide bytes",
+      string("P6 1 1 65535\n\x01\x02\x00\x01\xff\xff", 19), 258, 1, 65535);
+   galinhos.testRead("Short raster", "P6 100000 100000 255\nabc", false);
+   galinhos.testRead("Large width", "P6 1000000000 1 255\nabc", false);
+   galinhos.testMapped("bin/mapped.ppm", 255);
+   galinhos.testMapped("bin/mapped.ppm", 65535);
 
    cout << "\nEffects:\n";
    galinhos.testEffect("assets/imgs/blur.ppm", Blurring);
+   galinhos.testBlur("assets/imgs/blur-3.ppm", 3);
    galinhos.testEffect("assets/imgs/sharp-e.ppm", Edge_Sharpening);
    galinhos.testEffect("assets/imgs/embossing.ppm", Embossing);
    galinhos.testEffect("assets/imgs/enlarge.ppm", Enlarge);
+   galinhos.testEffect("assets/imgs/flip.ppm", Flip);
    galinhos.testEffect("assets/imgs/gray.ppm", Gray);
    galinhos.testEffect("assets/imgs/invert.ppm", Invert);
    galinhos.testEffect("assets/imgs/negative.ppm", Negative);
+   galinhos.testPointEffects("assets/imgs/negative-gray.ppm",
+      { Negative, Gray, Negative, Gray });
    galinhos.testEffect("assets/imgs/reduce.ppm", Reduce);
+   galinhos.testReduce("assets/imgs/reduce.ppm", 2);
+   galinhos.testReduce("assets/imgs/reduce-3.5.ppm", 3.5);
+   galinhos.testReduceSize("assets/imgs/reduce-size.ppm", 25, 40);
+   galinhos.testResize("assets/imgs/resize-bilinear.ppm", 143, 255, Bilinear);
+   galinhos.testResize("assets/imgs/resize-nearest.ppm", 100, 180, Nearest);
+   galinhos.testResize("assets/imgs/resize-bicubic.ppm", 160, 300, Bicubic);
+   galinhos.testEffect("assets/imgs/rotate-h.ppm", Rotate_Half);
    galinhos.testEffect("assets/imgs/rotate-l.ppm", Rotate_Left);
    galinhos.testEffect("assets/imgs/rotate.ppm", Rotate_Right);
    galinhos.testEffect("assets/imgs/sharp.ppm", Sharpening);
+   galinhos.testGeometricEffects("assets/imgs/transpose.ppm",
+      { Flip, Rotate_Left, Rotate_Half, Invert, Rotate_Right, Rotate_Left,
+      Flip, Rotate_Half });
+
+   cout << "\nThreads:\n";
+   galinhos.testEffect("assets/imgs/blur.ppm", Blurring, 4);
+   galinhos.testBlur("assets/imgs/blur-3.ppm", 3, 3);
+   galinhos.testEffect("assets/imgs/embossing.ppm", Embossing, 5);
+   galinhos.testEffect("assets/imgs/sharp.ppm", Sharpening, 8);
+   galinhos.testResize("assets/imgs/resize-bicubic.ppm", 160, 300, Bicubic,
+      6);
+   galinhos.testReduce("assets/imgs/reduce-3.5.ppm", 3.5, 4);
+
+   cout << "\nStreams:\n";
+   galinhos.testStream(1);
+   galinhos.testStream(10);
+   galinhos.testStream(STREAM_BAND_ROWS);
+
+   cout << "\nBatch:\n";
+   galinhos.testBatch("assets/imgs/galinhos.ppm", "assets/fonts/satisfy16.bdf",
+      "gray", "assets/imgs/gray.ppm");
+   galinhos.testBatchOption("assets/imgs/galinhos.ppm",
+      { "reduce", "+s", "0", "0" });
+   galinhos.testBatchOption("assets/imgs/galinhos.ppm",
+      { "blur", "+r", "x" });
 
    cout << "\nBorders:\n";
    galinhos.testBorders("assets/imgs/solid.ppm", Solid);
    galinhos.testBorders("assets/imgs/polaroid.ppm", Polaroid);
 
+   cout << "\nFonts:\n";
+
+   for (string font : { "ibm", "highlander", "satisfy", "netchild", "love" }) {
+      flowers.testGlyphs(font);
+   }
+
    int tests { galinhos.getTests() + flowers.getTests() };
    int success { galinhos.getSuccessTests() + flowers.getSuccessTests() };
 
@@ -0,0 +1,431 @@
+/**
+ * @file Convolution.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Convolution functions.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Masks of the image effects as compile-time data and the convolution of
+ * rows of packed channels with them. Each mask is a type, so every
+ * convolution is built for its own weights and the compiler unrolls the
+ * mask and drops its zeros. The sums are exact integers, which lets 8 bits
+ * channels run in 16 bits vector lanes with the dispatch of Kernels.hpp.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef CONVOLUTION_HPP
+#define CONVOLUTION_HPP
+
+#include <stddef.h>
+#include "Format.hpp"
+#include "Kernels.hpp"
+#include "Pixel.hpp"
+
+#define MASK_SIZE 3          /**< Mask width and height */
+#define DIVIDE_BY_NINE 7282  /**< (x * it) >> 16 is x / 9 for x below 32760 */
+#define CONVOLUTION_BLOCK 16 /**< Channels of a vector of 16 bits lanes */
+
+/**
+ * @struct SharpeningMask struct.
+ * @brief Mask of the sharpening effect.
+ */
+struct SharpeningMask {
+   static constexpr int weights[MASK_SIZE][MASK_SIZE] = {
+      {  0, -1,  0 },
+      { -1,  5, -1 },
+      {  0, -1,  0 }
+   }; /**< Weights of the neighbors, row after row */
+
+   static constexpr int divisor = 1; /**< Divisor of the sums */
+};
+
+constexpr int SharpeningMask::weights[MASK_SIZE][MASK_SIZE];
+
+/**
+ * @struct EdgeSharpeningMask struct.
+ * @brief Mask of the edge sharpening effect.
+ */
+struct EdgeSharpeningMask {
+   static constexpr int weights[MASK_SIZE][MASK_SIZE] = {
+      { -1, -1, -1 },
+      { -1,  9, -1 },
+      { -1, -1, -1 }
+   }; /**< Weights of the neighbors, row after row */
+
+   static constexpr int divisor = 1; /**< Divisor of the sums */
+};
+
+constexpr int EdgeSharpeningMask::weights[MASK_SIZE][MASK_SIZE];
+
+/**
+ * @struct EmbossingMask struct.
+ * @brief Mask of the embossing effect.
+ */
+struct EmbossingMask {
+   static constexpr int weights[MASK_SIZE][MASK_SIZE] = {
+      { -2, -1,  0 },
+      { -1,  1,  1 },
+      {  0,  1,  2 }
+   }; /**< Weights of the neighbors, row after row */
+
+   static constexpr int divisor = 1; /**< Divisor of the sums */
+};
+
+constexpr int EmbossingMask::weights[MASK_SIZE][MASK_SIZE];
+
+/**
+ * @struct BlurringMask struct.
+ * @brief Mask of the blurring effect.
+ *
+ * @details The blur was once the float mask of weights (float) (1.0 / 9),
+ * whose sums fall below the exact mean for some neighbors with a multiple
+ * of 9 as sum. Those sums are computed again like the float mask, so the
+ * results stay the same to the last bit.
+ */
+struct BlurringMask {
+   static constexpr int weights[MASK_SIZE][MASK_SIZE] = {
+      { 1, 1, 1 },
+      { 1, 1, 1 },
+      { 1, 1, 1 }
+   }; /**< Weights of the neighbors, row after row */
+
+   static constexpr int divisor = 9; /**< Divisor of the sums */
+};
+
+constexpr int BlurringMask::weights[MASK_SIZE][MASK_SIZE];
+
+/**
+ * @brief Sum the neighbors of a channel like the float masks did.
+ *
+ * @details The weights are the float nearest to 1 / divisor and the sum
+ * keeps the order of the rows and columns of the float masks.
+ *
+ * @tparam Mask Mask of the effect.
+ * @tparam Channel Type of a single channel.
+ * @param above Channel in the row above the pixel.
+ * @param middle Channel of the pixel.
+ * @param below Channel in the row below the pixel.
+ * @param before Channels from the channel to the same channel of the
+ * pixel before.
+ * @param after Channels from the channel to the same channel of the pixel
+ * after.
+ * @return The float sum.
+ */
+template <typename Mask, typename Channel>
+float floatSum(Channel const* above, Channel const* middle,
+   Channel const* below, int before, int after)
+{
+   Channel const* const rows[MASK_SIZE] = { above, middle, below };
+   int const offsets[MASK_SIZE] = { -before, 0, after };
+   float weight { (float) (1.0 / Mask::divisor) };
+   float sum { 0 };
+
+   for (int row { 0 }; row < MASK_SIZE; row++) {
+      for (int column { 0 }; column < MASK_SIZE; column++) {
+         sum += rows[row][offsets[column]]
+            * (weight * Mask::weights[row][column]);
+      }
+   }
+
+   return sum;
+}
+
+/**
+ * @brief Put a mask on the channel of a pixel.
+ *
+ * @details The sum is divided by the divisor of the mask, truncated
+ * towards zero and limited to the colors, like the channels of a pixel.
+ *
+ * @tparam Mask Mask of the effect.
+ * @tparam Channel Type of a single channel.
+ * @param above Channel in the row above the pixel.
+ * @param middle Channel of the pixel.
+ * @param below Channel in the row below the pixel.
+ * @param before Channels from the channel to the same channel of the
+ * pixel before.
+ * @param after Channels from the channel to the same channel of the pixel
+ * after.
+ * @param colors Maximum of colors per pixel channel.
+ * @return The filtered channel.
+ * @see floatSum()
+ */
+template <typename Mask, typename Channel>
+inline Channel convolveChannel(Channel const* above, Channel const* middle,
+   Channel const* below, int before, int after, int colors)
+{
+   /*
+    * Sums the channels multiplied by their weight in the mask, row after
+    * row.
+    */
+   int sum { above[-before] * Mask::weights[0][0] };
+   sum += above[0] * Mask::weights[0][1];
+   sum += above[after] * Mask::weights[0][2];
+   sum += middle[-before] * Mask::weights[1][0];
+   sum += middle[0] * Mask::weights[1][1];
+   sum += middle[after] * Mask::weights[1][2];
+   sum += below[-before] * Mask::weights[2][0];
+   sum += below[0] * Mask::weights[2][1];
+   sum += below[after] * Mask::weights[2][2];
+
+   int value { sum };
+
+   if (Mask::divisor > 1) {
+      value = sum / Mask::divisor;
+
+      if (value * Mask::divisor == sum) {
+         value = int(floatSum<Mask>(above, middle, below, before, after));
+      }
+   }
+
+   return (Channel) (value < MIN_COLOR ? MIN_COLOR :
+      value > colors ? colors : value);
+}
+
+#if defined(KERNELS_X86)
+/**
+ * @brief Add a neighbor times its weight to 16 bits lanes with AVX2.
+ *
+ * @tparam Weight Weight of the neighbor.
+ * @param sum Sums of the lanes.
+ * @param channel First of the 16 channels of the neighbor.
+ * @return The new sums.
+ */
+template <int Weight>
+__attribute__((target("avx2")))
+inline __m256i addNeighborAVX2(__m256i sum, RGB8::Channel const* channel) {
+   if (Weight == 0) {
+      return sum;
+   }
+
+   __m256i lanes { _mm256_cvtepu8_epi16(
+      _mm_loadu_si128((__m128i const*) channel)) };
+
+   if (Weight == 1) {
+      return _mm256_add_epi16(sum, lanes);
+   } else if (Weight == -1) {
+      return _mm256_sub_epi16(sum, lanes);
+   }
+
+   return _mm256_add_epi16(sum,
+      _mm256_mullo_epi16(lanes, _mm256_set1_epi16((short) Weight)));
+}
+
+/**
+ * @brief Sum 8 neighbors like the float masks did, in float lanes.
+ *
+ * @tparam Mask Mask of the effect.
+ * @param rows Channels of the rows above, in and below the first pixel.
+ * @return The sums truncated towards zero, in 32 bits lanes.
+ * @see floatSum()
+ */
+template <typename Mask>
+__attribute__((target("avx2")))
+__m256i floatSumAVX2(RGB8::Channel const* const rows[MASK_SIZE]) {
+   int const offsets[MASK_SIZE] = {
+      -CHANNELS_PER_PIXEL, 0, CHANNELS_PER_PIXEL
+   };
+   float weight { (float) (1.0 / Mask::divisor) };
+   __m256 sum { _mm256_setzero_ps() };
+
+   for (int row { 0 }; row < MASK_SIZE; row++) {
+      for (int column { 0 }; column < MASK_SIZE; column++) {
+         __m256 lanes { _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(
+            _mm_loadl_epi64((__m128i const*) (rows[row] + offsets[column]))
+         )) };
+
+         sum = _mm256_add_ps(sum, _mm256_mul_ps(lanes,
+            _mm256_set1_ps(weight * Mask::weights[row][column])));
+      }
+   }
+
+   return _mm256_cvttps_epi32(sum);
+}
+
+/**
+ * @brief Put a mask on the channels of a row of 8 bits with AVX2, 16
+ * channels at a time.
+ *
+ * @details The sums fit in 16 bits lanes. The blur divides them with a
+ * fixed-point multiplication, and the blocks with a sum multiple of 9 are
+ * summed again in float lanes, like the scalar loop.
+ *
+ * @tparam Mask Mask of the effect.
+ * @param above Row above.
+ * @param middle Row of the channels.
+ * @param below Row below.
+ * @param channels Number of channels of the rows.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the filtered row.
+ * @return The first channel left, counting from the second pixel.
+ * @see convolveChannel()
+ */
+template <typename Mask>
+__attribute__((target("avx2")))
+size_t convolveAVX2(RGB8::Channel const* above, RGB8::Channel const* middle,
+   RGB8::Channel const* below, size_t channels, int colors,
+   RGB8::Channel* destination)
+{
+   static_assert(Mask::divisor == 1 || Mask::divisor == 9,
+      "The vectors only divide by 9");
+
+   __m256i minimum { _mm256_setzero_si256() };
+   __m256i maximum { _mm256_set1_epi16((short) colors) };
+   __m256i reciprocal { _mm256_set1_epi16((short) DIVIDE_BY_NINE) };
+   __m256i nine { _mm256_set1_epi16(9) };
+   size_t index { CHANNELS_PER_PIXEL };
+
+   for (; index + CONVOLUTION_BLOCK + CHANNELS_PER_PIXEL <= channels;
+      index += CONVOLUTION_BLOCK)
+   {
+      RGB8::Channel const* before[MASK_SIZE] = {
+         above + index - CHANNELS_PER_PIXEL,
+         middle + index - CHANNELS_PER_PIXEL,
+         below + index - CHANNELS_PER_PIXEL
+      };
+      __m256i sum { _mm256_setzero_si256() };
+
+      sum = addNeighborAVX2<Mask::weights[0][0]>(sum, before[0]);
+      sum = addNeighborAVX2<Mask::weights[0][1]>(sum, before[0] + 3);
+      sum = addNeighborAVX2<Mask::weights[0][2]>(sum, before[0] + 6);
+      sum = addNeighborAVX2<Mask::weights[1][0]>(sum, before[1]);
+      sum = addNeighborAVX2<Mask::weights[1][1]>(sum, before[1] + 3);
+      sum = addNeighborAVX2<Mask::weights[1][2]>(sum, before[1] + 6);
+      sum = addNeighborAVX2<Mask::weights[2][0]>(sum, before[2]);
+      sum = addNeighborAVX2<Mask::weights[2][1]>(sum, before[2] + 3);
+      sum = addNeighborAVX2<Mask::weights[2][2]>(sum, before[2] + 6);
+
+      if (Mask::divisor > 1) {
+         __m256i quotient { _mm256_mulhi_epu16(sum, reciprocal) };
+         __m256i exact { _mm256_cmpeq_epi16(sum,
+            _mm256_mullo_epi16(quotient, nine)) };
+
+         if (!_mm256_testz_si256(exact, exact)) {
+            RGB8::Channel const* const first[MASK_SIZE] = {
+               above + index, middle + index, below + index
+            };
+            RGB8::Channel const* const second[MASK_SIZE] = {
+               above + index + 8, middle + index + 8, below + index + 8
+            };
+
+            __m256i sums { _mm256_permute4x64_epi64(_mm256_packus_epi32(
+               floatSumAVX2<Mask>(first), floatSumAVX2<Mask>(second)),
+               0xD8) };
+
+            quotient = _mm256_blendv_epi8(quotient, sums, exact);
+         }
+
+         sum = quotient;
+      }
+
+      sum = _mm256_min_epi16(_mm256_max_epi16(sum, minimum), maximum);
+
+      _mm_storeu_si128((__m128i*) (destination + index), _mm_packus_epi16(
+         _mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+   }
+
+   return index;
+}
+#endif
+
+/**
+ * @brief Put a mask on the channels of a row of 8 bits, as many as the
+ * vectors of the processor take.
+ *
+ * @tparam Mask Mask of the effect.
+ * @param above Row above.
+ * @param middle Row of the channels.
+ * @param below Row below.
+ * @param channels Number of channels of the rows.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the filtered row.
+ * @return The first channel left, counting from the second pixel.
+ * @see convolveAVX2()
+ */
+template <typename Mask>
+size_t convolveVectors(RGB8::Channel const* above,
+   RGB8::Channel const* middle, RGB8::Channel const* below, size_t channels,
+   int colors, RGB8::Channel* destination)
+{
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      return convolveAVX2<Mask>(above, middle, below, channels, colors,
+         destination);
+   }
+#endif
+
+   return CHANNELS_PER_PIXEL;
+}
+
+/**
+ * @brief Put a mask on the channels of a row of 16 bits, as many as the
+ * vectors of the processor take.
+ *
+ * @details The sums of 16 bits channels do not fit in 16 bits lanes, so
+ * these rows keep the scalar loop.
+ *
+ * @tparam Mask Mask of the effect.
+ * @return The first channel left, counting from the second pixel.
+ */
+template <typename Mask>
+size_t convolveVectors(RGB16::Channel const*, RGB16::Channel const*,
+   RGB16::Channel const*, size_t, int, RGB16::Channel*)
+{
+   return CHANNELS_PER_PIXEL;
+}
+
+/**
+ * @brief Put a mask on a row of packed channels.
+ *
+ * @details The first and the last pixels take their missing neighbors
+ * from the nearest edge in a pass of their own, so the loop over the other
+ * channels reaches the neighbors with constant offsets and no checks.
+ *
+ * @tparam Mask Mask of the effect.
+ * @tparam Channel Type of a single channel.
+ * @param rows Rows above, in and below the row, the nearest row of the
+ * image when it has none.
+ * @param width Pixels of the rows.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the filtered row.
+ * @see convolveVectors()
+ * @see convolveChannel()
+ */
+template <typename Mask, typename Channel>
+void convolveRow(Channel const* const rows[MASK_SIZE], int width,
+   int colors, Channel* destination)
+{
+   if (width < 1) {
+      return;
+   }
+
+   Channel const* above { rows[0] };
+   Channel const* middle { rows[1] };
+   Channel const* below { rows[2] };
+
+   size_t channels { (size_t) width * CHANNELS_PER_PIXEL };
+   int step { width > 1 ? CHANNELS_PER_PIXEL : 0 };
+
+   for (size_t index { convolveVectors<Mask>(above, middle, below,
+      channels, colors, destination) };
+      index + CHANNELS_PER_PIXEL < channels; index++)
+   {
+      destination[index] = convolveChannel<Mask>(above + index,
+         middle + index, below + index, CHANNELS_PER_PIXEL,
+         CHANNELS_PER_PIXEL, colors);
+   }
+
+   /*
+    * The edge pixels repeat themselves in place of the missing neighbors.
+    */
+   for (size_t index { 0 }; index < CHANNELS_PER_PIXEL; index++) {
+      size_t last { channels - CHANNELS_PER_PIXEL + index };
+
+      destination[index] = convolveChannel<Mask>(above + index,
+         middle + index, below + index, 0, step, colors);
+      destination[last] = convolveChannel<Mask>(above + last,
+         middle + last, below + last, step, 0, colors);
+   }
+}
+
+#endif // CONVOLUTION_HPP
@@ -27,16 +27,30 @@ enum Effects {
    Edge_Sharpening,
    Embossing,
    Enlarge,
+   Flip,
    Gray,
    Invert,
    Negative,
    Reduce,
+   Resize,
+   Rotate_Half,
    Rotate_Left,
    Rotate_Right,
    Sharpening,
    Effect_None
 };
 
+/**
+ * @enum Filters enumeration.
+ * @brief Enumeration with all resampling filters of the "Editor" class.
+ */
+enum Filters {
+   Nearest,
+   Bilinear,
+   Bicubic,
+   Filter_None
+};
+
 /**
  * @enum Borders enumeration.
  * @brief Enumeration with all borders of the "Editor" class.
@@ -82,12 +96,18 @@ Effects getEffectByName(std::string effect_name) {
       return Rotate_Right;
    } else if (effect_name == "rotate-l") {
       return Rotate_Left;
+   } else if (effect_name == "rotate-h") {
+      return Rotate_Half;
    } else if (effect_name == "invert") {
       return Invert;
+   } else if (effect_name == "flip") {
+      return Flip;
    } else if (effect_name == "enlarge") {
       return Enlarge;
    } else if (effect_name == "reduce") {
       return Reduce;
+   } else if (effect_name == "resize") {
+      return Resize;
    } else if (effect_name == "sharp") {
       return Sharpening;
    } else if (effect_name == "sharp-e") {
@@ -101,6 +121,24 @@ Effects getEffectByName(std::string effect_name) {
    return Effect_None;
 }
 
+/**
+ * @brief Get the value from Filters enum by filter name.
+ * 
+ * @param filter_name Filter name.
+ * @return An Filters value.
+ */
+Filters getFilterByName(std::string filter_name) {
+   if (filter_name == "nearest") {
+      return Nearest;
+   } else if (filter_name == "bilinear") {
+      return Bilinear;
+   } else if (filter_name == "bicubic") {
+      return Bicubic;
+   }
+
+   return Filter_None;
+}
+
 /**
  * @brief Get the value from Borders enum by border type.
  * 
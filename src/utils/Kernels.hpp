@@ -0,0 +1,642 @@
+/**
+ * @file Kernels.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Kernels functions.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Point-wise and row kernels over packed channels. On x86 processors the
+ * kernels pick at runtime the widest instructions the processor has, AVX2,
+ * SSSE3 or the SSE2 of every x86-64 processor, and end with a portable
+ * scalar loop, which also handles the channels left over by the vectors.
+ * Other processors and compilers only run the scalar loops.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <stddef.h>
+#include "Format.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 /**< Kernels with runtime dispatch to x86 extensions */
+#include <immintrin.h>
+#endif
+
+#define DIVIDE_BY_THREE 0xAAAB  /**< (x * it) >> 17 is x / 3 for 16 bits x */
+#define SHUFFLE_ZERO 0x80       /**< Shuffle index that writes a zero */
+#define GRAYSCALE_BLOCK 48      /**< Channels of the 16 pixels of a block */
+#define REVERSE_BLOCK 48        /**< Bytes of the blocks of the reversal */
+
+/**
+ * @brief Transform pixels into grayscale, one pixel at a time.
+ *
+ * @tparam Channel Type of a single channel.
+ * @param channel First channel of the first pixel.
+ * @param channels Number of channels, a multiple of three.
+ * @param colors Maximum of colors, not below any channel.
+ * @param before Transform the pixels into negative before.
+ * @param after Transform the pixels into negative after.
+ */
+template <typename Channel>
+void grayscaleScalar(Channel* channel, size_t channels, int colors,
+   bool before, bool after)
+{
+   for (size_t index { 0 }; index < channels; index += 3) {
+      int sum { channel[index] + channel[index + 1] + channel[index + 2] };
+
+      if (before) {
+         sum = 3 * colors - sum;
+      }
+
+      /*
+       * Calculate the average of the channels in the pixel.
+       */
+      Channel average { (Channel) (after ? colors - sum / 3 : sum / 3) };
+
+      channel[index] = average;
+      channel[index + 1] = average;
+      channel[index + 2] = average;
+   }
+}
+
+/**
+ * @brief Transform channels into negative, one channel at a time.
+ *
+ * @tparam Channel Type of a single channel.
+ * @param channel First channel.
+ * @param channels Number of channels.
+ * @param colors Maximum of colors, not below any channel.
+ */
+template <typename Channel>
+void negativeScalar(Channel* channel, size_t channels, int colors) {
+   for (size_t index { 0 }; index < channels; index++) {
+      /*
+       * It subtracts the maximum number of colors per channel by the value
+       * of each one.
+       */
+      channel[index] = (Channel) (colors - channel[index]);
+   }
+}
+
+/**
+ * @brief Reverse the order of the pixels of a row, one pixel at a time.
+ *
+ * @tparam Channel Type of a single channel.
+ * @param channel First channel of the first pixel.
+ * @param pixels Number of pixels.
+ */
+template <typename Channel>
+void reverseScalar(Channel* channel, size_t pixels) {
+   Channel* left { channel };
+   Channel* right { channel + pixels * 3 };
+
+   for (size_t index { 0 }; index < pixels / 2; index++) {
+      right -= 3;
+
+      for (int color { 0 }; color < 3; color++) {
+         Channel swap { left[color] };
+         left[color] = right[color];
+         right[color] = swap;
+      }
+
+      left += 3;
+   }
+}
+
+#if defined(KERNELS_X86)
+/**
+ * @struct GrayscaleShuffles struct.
+ * @brief Byte shuffles between the channels of a block of 16 pixels and
+ * their averages.
+ *
+ * @details A block is three vectors of 16 channels. The first half of the
+ * pixels lives in the first two vectors and the second half in the last
+ * two, so each color of a half is gathered from two vectors into 16 bits
+ * lanes. The averages are then spread back to the three channels of each
+ * pixel.
+ */
+struct GrayscaleShuffles {
+   unsigned char gather[2][3][2][16]; /**< Half, color, vector, byte */
+   unsigned char spread[3][16];       /**< Vector, byte */
+
+   /**
+    * @brief Construct the shuffles.
+    */
+   GrayscaleShuffles() {
+      for (int half { 0 }; half < 2; half++) {
+         for (int color { 0 }; color < 3; color++) {
+            for (int vector { 0 }; vector < 2; vector++) {
+               for (int lane { 0 }; lane < 8; lane++) {
+                  int byte { 3 * (8 * half + lane) + color };
+                  bool inside { byte / 16 == half + vector };
+
+                  gather[half][color][vector][2 * lane] = (unsigned char)
+                     (inside ? byte % 16 : SHUFFLE_ZERO);
+                  gather[half][color][vector][2 * lane + 1] = SHUFFLE_ZERO;
+               }
+            }
+         }
+      }
+
+      for (int vector { 0 }; vector < 3; vector++) {
+         for (int byte { 0 }; byte < 16; byte++) {
+            spread[vector][byte] = (unsigned char) ((16 * vector + byte) / 3);
+         }
+      }
+   }
+};
+
+/**
+ * @brief Get the shuffles of the grayscale blocks, built once.
+ *
+ * @return The shuffles.
+ */
+GrayscaleShuffles const& getGrayscaleShuffles() {
+   static GrayscaleShuffles const shuffles;
+   return shuffles;
+}
+
+/**
+ * @struct ReverseShuffles struct.
+ * @brief Byte shuffles that reverse the order of the pixels of a block.
+ *
+ * @details A block is three vectors of 16 bytes, with 16 pixels of 8 bits
+ * channels or 8 pixels of 16 bits channels. Each vector of the reversed
+ * block gathers its bytes from the three vectors of the block.
+ */
+struct ReverseShuffles {
+   unsigned char shuffle[2][3][3][16]; /**< Depth, output, input, byte */
+
+   /**
+    * @brief Construct the shuffles.
+    */
+   ReverseShuffles() {
+      for (int depth { 0 }; depth < 2; depth++) {
+         int size { 3 * (depth + 1) };
+
+         for (int output { 0 }; output < 3; output++) {
+            for (int byte { 0 }; byte < 16; byte++) {
+               int position { 16 * output + byte };
+               int pixel { REVERSE_BLOCK / size - 1 - position / size };
+               int source { pixel * size + position % size };
+
+               for (int input { 0 }; input < 3; input++) {
+                  shuffle[depth][output][input][byte] = (unsigned char)
+                     (source / 16 == input ? source % 16 : SHUFFLE_ZERO);
+               }
+            }
+         }
+      }
+   }
+};
+
+/**
+ * @brief Get the shuffles of the reversed blocks, built once.
+ *
+ * @return The shuffles.
+ */
+ReverseShuffles const& getReverseShuffles() {
+   static ReverseShuffles const shuffles;
+   return shuffles;
+}
+
+/**
+ * @brief Reverse the order of the pixels of a row with SSSE3, swapping a
+ * block of each end at a time.
+ *
+ * @param bytes First byte of the row.
+ * @param size Bytes of the row.
+ * @param depth Bytes per channel, 1 or 2.
+ * @return Bytes reversed at each end, a multiple of #REVERSE_BLOCK.
+ * @see ReverseShuffles
+ */
+__attribute__((target("ssse3")))
+size_t reverseSSSE3(unsigned char* bytes, size_t size, int depth) {
+   ReverseShuffles const& shuffles { getReverseShuffles() };
+
+   __m128i shuffle[3][3];
+
+   for (int output { 0 }; output < 3; output++) {
+      for (int input { 0 }; input < 3; input++) {
+         shuffle[output][input] = _mm_loadu_si128((__m128i const*)
+            shuffles.shuffle[depth - 1][output][input]);
+      }
+   }
+
+   size_t left { 0 };
+
+   for (; 2 * (left + REVERSE_BLOCK) <= size; left += REVERSE_BLOCK) {
+      unsigned char* ends[2] = {
+         bytes + left, bytes + size - left - REVERSE_BLOCK
+      };
+      __m128i blocks[2][3];
+
+      for (int end { 0 }; end < 2; end++) {
+         for (int input { 0 }; input < 3; input++) {
+            blocks[end][input] = _mm_loadu_si128(
+               (__m128i const*) (ends[end] + 16 * input));
+         }
+      }
+
+      /*
+       * Each block is reversed into the other end of the row.
+       */
+      for (int end { 0 }; end < 2; end++) {
+         for (int output { 0 }; output < 3; output++) {
+            __m128i vector { _mm_setzero_si128() };
+
+            for (int input { 0 }; input < 3; input++) {
+               vector = _mm_or_si128(vector, _mm_shuffle_epi8(
+                  blocks[end][input], shuffle[output][input]));
+            }
+
+            _mm_storeu_si128((__m128i*) (ends[1 - end] + 16 * output),
+               vector);
+         }
+      }
+   }
+
+   return left;
+}
+
+/**
+ * @brief Transform 8 bits pixels into grayscale with SSSE3, 16 pixels at a
+ * time.
+ *
+ * @param channel First channel of the first pixel.
+ * @param channels Number of channels, a multiple of three.
+ * @param colors Maximum of colors, not below any channel.
+ * @param before Transform the pixels into negative before.
+ * @param after Transform the pixels into negative after.
+ * @return Number of channels transformed, a multiple of #GRAYSCALE_BLOCK.
+ * @see GrayscaleShuffles
+ */
+__attribute__((target("ssse3")))
+size_t grayscaleSSSE3(RGB8::Channel* channel, size_t channels, int colors,
+   bool before, bool after)
+{
+   GrayscaleShuffles const& shuffles { getGrayscaleShuffles() };
+
+   __m128i gather[2][3][2];
+   __m128i spread[3];
+
+   for (int half { 0 }; half < 2; half++) {
+      for (int color { 0 }; color < 3; color++) {
+         for (int vector { 0 }; vector < 2; vector++) {
+            gather[half][color][vector] = _mm_loadu_si128(
+               (__m128i const*) shuffles.gather[half][color][vector]);
+         }
+      }
+   }
+
+   for (int vector { 0 }; vector < 3; vector++) {
+      spread[vector] = _mm_loadu_si128(
+         (__m128i const*) shuffles.spread[vector]);
+   }
+
+   __m128i third { _mm_set1_epi16((short) DIVIDE_BY_THREE) };
+   __m128i maximum { _mm_set1_epi8((char) colors) };
+   size_t index { 0 };
+
+   for (; index + GRAYSCALE_BLOCK <= channels; index += GRAYSCALE_BLOCK) {
+      __m128i block[3];
+      __m128i averages[2];
+
+      for (int vector { 0 }; vector < 3; vector++) {
+         block[vector] = _mm_loadu_si128(
+            (__m128i const*) (channel + index + 16 * vector));
+
+         if (before) {
+            block[vector] = _mm_sub_epi8(maximum, block[vector]);
+         }
+      }
+
+      for (int half { 0 }; half < 2; half++) {
+         __m128i sum { _mm_setzero_si128() };
+
+         for (int color { 0 }; color < 3; color++) {
+            sum = _mm_add_epi16(sum, _mm_or_si128(
+               _mm_shuffle_epi8(block[half], gather[half][color][0]),
+               _mm_shuffle_epi8(block[half + 1], gather[half][color][1])
+            ));
+         }
+
+         averages[half] = _mm_srli_epi16(_mm_mulhi_epu16(sum, third), 1);
+      }
+
+      __m128i pixels { _mm_packus_epi16(averages[0], averages[1]) };
+
+      if (after) {
+         pixels = _mm_sub_epi8(maximum, pixels);
+      }
+
+      for (int vector { 0 }; vector < 3; vector++) {
+         _mm_storeu_si128((__m128i*) (channel + index + 16 * vector),
+            _mm_shuffle_epi8(pixels, spread[vector]));
+      }
+   }
+
+   return index;
+}
+
+/**
+ * @brief Transform 8 bits pixels into grayscale with AVX2, 32 pixels at a
+ * time.
+ *
+ * @details The shuffles of AVX2 do not cross the two halves of a register,
+ * so each half runs the block of grayscaleSSSE3() on its own 16 pixels.
+ *
+ * @param channel First channel of the first pixel.
+ * @param channels Number of channels, a multiple of three.
+ * @param colors Maximum of colors, not below any channel.
+ * @param before Transform the pixels into negative before.
+ * @param after Transform the pixels into negative after.
+ * @return Number of channels transformed, a multiple of #GRAYSCALE_BLOCK.
+ * @see grayscaleSSSE3()
+ */
+__attribute__((target("avx2")))
+size_t grayscaleAVX2(RGB8::Channel* channel, size_t channels, int colors,
+   bool before, bool after)
+{
+   GrayscaleShuffles const& shuffles { getGrayscaleShuffles() };
+
+   __m256i gather[2][3][2];
+   __m256i spread[3];
+
+   for (int half { 0 }; half < 2; half++) {
+      for (int color { 0 }; color < 3; color++) {
+         for (int vector { 0 }; vector < 2; vector++) {
+            gather[half][color][vector] = _mm256_broadcastsi128_si256(
+               _mm_loadu_si128(
+                  (__m128i const*) shuffles.gather[half][color][vector]));
+         }
+      }
+   }
+
+   for (int vector { 0 }; vector < 3; vector++) {
+      spread[vector] = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+         (__m128i const*) shuffles.spread[vector]));
+   }
+
+   __m256i third { _mm256_set1_epi16((short) DIVIDE_BY_THREE) };
+   __m256i maximum { _mm256_set1_epi8((char) colors) };
+   size_t index { 0 };
+
+   for (; index + 2 * GRAYSCALE_BLOCK <= channels;
+      index += 2 * GRAYSCALE_BLOCK)
+   {
+      RGB8::Channel* first { channel + index };
+      RGB8::Channel* second { first + GRAYSCALE_BLOCK };
+      __m256i block[3];
+      __m256i averages[2];
+
+      for (int vector { 0 }; vector < 3; vector++) {
+         block[vector] = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(
+               (__m128i const*) (first + 16 * vector))),
+            _mm_loadu_si128((__m128i const*) (second + 16 * vector)), 1);
+
+         if (before) {
+            block[vector] = _mm256_sub_epi8(maximum, block[vector]);
+         }
+      }
+
+      for (int half { 0 }; half < 2; half++) {
+         __m256i sum { _mm256_setzero_si256() };
+
+         for (int color { 0 }; color < 3; color++) {
+            sum = _mm256_add_epi16(sum, _mm256_or_si256(
+               _mm256_shuffle_epi8(block[half], gather[half][color][0]),
+               _mm256_shuffle_epi8(block[half + 1], gather[half][color][1])
+            ));
+         }
+
+         averages[half] = _mm256_srli_epi16(
+            _mm256_mulhi_epu16(sum, third), 1);
+      }
+
+      __m256i pixels { _mm256_packus_epi16(averages[0], averages[1]) };
+
+      if (after) {
+         pixels = _mm256_sub_epi8(maximum, pixels);
+      }
+
+      for (int vector { 0 }; vector < 3; vector++) {
+         __m256i spread_pixels {
+            _mm256_shuffle_epi8(pixels, spread[vector])
+         };
+
+         _mm_storeu_si128((__m128i*) (first + 16 * vector),
+            _mm256_castsi256_si128(spread_pixels));
+         _mm_storeu_si128((__m128i*) (second + 16 * vector),
+            _mm256_extracti128_si256(spread_pixels, 1));
+      }
+   }
+
+   return index;
+}
+
+/**
+ * @brief Transform 8 bits channels into negative with AVX2, 32 channels at
+ * a time.
+ *
+ * @param channel First channel.
+ * @param channels Number of channels.
+ * @param colors Maximum of colors, not below any channel.
+ * @return Number of channels transformed.
+ */
+__attribute__((target("avx2")))
+size_t negativeAVX2(RGB8::Channel* channel, size_t channels, int colors) {
+   __m256i maximum { _mm256_set1_epi8((char) colors) };
+   size_t index { 0 };
+
+   for (; index + 32 <= channels; index += 32) {
+      __m256i* lanes { (__m256i*) (channel + index) };
+      _mm256_storeu_si256(lanes,
+         _mm256_sub_epi8(maximum, _mm256_loadu_si256(lanes)));
+   }
+
+   return index;
+}
+
+/**
+ * @brief Transform 16 bits channels into negative with AVX2, 16 channels
+ * at a time.
+ *
+ * @param channel First channel.
+ * @param channels Number of channels.
+ * @param colors Maximum of colors, not below any channel.
+ * @return Number of channels transformed.
+ */
+__attribute__((target("avx2")))
+size_t negativeAVX2(RGB16::Channel* channel, size_t channels, int colors) {
+   __m256i maximum { _mm256_set1_epi16((short) colors) };
+   size_t index { 0 };
+
+   for (; index + 16 <= channels; index += 16) {
+      __m256i* lanes { (__m256i*) (channel + index) };
+      _mm256_storeu_si256(lanes,
+         _mm256_sub_epi16(maximum, _mm256_loadu_si256(lanes)));
+   }
+
+   return index;
+}
+
+/**
+ * @brief Checks if the processor runs AVX2 instructions.
+ *
+ * @return An boolean.
+ */
+bool hasAVX2() {
+   static bool const supported { (bool) __builtin_cpu_supports("avx2") };
+   return supported;
+}
+
+/**
+ * @brief Checks if the processor runs SSSE3 instructions.
+ *
+ * @return An boolean.
+ */
+bool hasSSSE3() {
+   static bool const supported { (bool) __builtin_cpu_supports("ssse3") };
+   return supported;
+}
+#endif
+
+/**
+ * @brief Transform 8 bits pixels into grayscale.
+ *
+ * @details The vectors divide by three with a multiplication, which gives
+ * the same averages of the integer division of the scalar loop. The
+ * negatives around the grayscale are fused into the same pass, so any
+ * chain of grayscale and negative effects reads and writes the pixels
+ * once.
+ *
+ * @param channel First channel of the first pixel.
+ * @param channels Number of channels, a multiple of three.
+ * @param colors Maximum of colors, not below any channel.
+ * @param before Transform the pixels into negative before.
+ * @param after Transform the pixels into negative after.
+ * @see grayscaleScalar()
+ */
+void grayscaleChannels(RGB8::Channel* channel, size_t channels, int colors,
+   bool before = false, bool after = false)
+{
+   size_t index { 0 };
+
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      index = grayscaleAVX2(channel, channels, colors, before, after);
+   } else if (hasSSSE3()) {
+      index = grayscaleSSSE3(channel, channels, colors, before, after);
+   }
+#endif
+
+   grayscaleScalar(channel + index, channels - index, colors, before,
+      after);
+}
+
+/**
+ * @brief Transform 16 bits pixels into grayscale.
+ *
+ * @details The sums of three channels do not fit in 16 bits lanes, so
+ * these pixels keep the scalar loop.
+ *
+ * @param channel First channel of the first pixel.
+ * @param channels Number of channels, a multiple of three.
+ * @param colors Maximum of colors, not below any channel.
+ * @param before Transform the pixels into negative before.
+ * @param after Transform the pixels into negative after.
+ * @see grayscaleScalar()
+ */
+void grayscaleChannels(RGB16::Channel* channel, size_t channels,
+   int colors, bool before = false, bool after = false)
+{
+   grayscaleScalar(channel, channels, colors, before, after);
+}
+
+/**
+ * @brief Reverse the order of the pixels of a row in place.
+ *
+ * @tparam Channel Type of a single channel, of #RGB8 or #RGB16.
+ * @param channel First channel of the first pixel.
+ * @param pixels Number of pixels.
+ * @see reverseScalar()
+ */
+template <typename Channel>
+void reverseChannels(Channel* channel, size_t pixels) {
+   size_t index { 0 };
+
+#if defined(KERNELS_X86)
+   if (hasSSSE3()) {
+      index = reverseSSSE3((unsigned char*) channel,
+         pixels * 3 * sizeof(Channel), sizeof(Channel))
+         / (3 * sizeof(Channel));
+   }
+#endif
+
+   reverseScalar(channel + index * 3, pixels - 2 * index);
+}
+
+/**
+ * @brief Transform 8 bits channels into negative.
+ *
+ * @param channel First channel.
+ * @param channels Number of channels.
+ * @param colors Maximum of colors, not below any channel.
+ * @see negativeScalar()
+ */
+void negativeChannels(RGB8::Channel* channel, size_t channels, int colors) {
+   size_t index { 0 };
+
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      index = negativeAVX2(channel, channels, colors);
+   }
+#endif
+
+#if defined(KERNELS_X86) && defined(__SSE2__)
+   __m128i maximum { _mm_set1_epi8((char) colors) };
+
+   for (; index + 16 <= channels; index += 16) {
+      __m128i* lanes { (__m128i*) (channel + index) };
+      _mm_storeu_si128(lanes, _mm_sub_epi8(maximum, _mm_loadu_si128(lanes)));
+   }
+#endif
+
+   negativeScalar(channel + index, channels - index, colors);
+}
+
+/**
+ * @brief Transform 16 bits channels into negative.
+ *
+ * @param channel First channel.
+ * @param channels Number of channels.
+ * @param colors Maximum of colors, not below any channel.
+ * @see negativeScalar()
+ */
+void negativeChannels(RGB16::Channel* channel, size_t channels, int colors) {
+   size_t index { 0 };
+
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      index = negativeAVX2(channel, channels, colors);
+   }
+#endif
+
+#if defined(KERNELS_X86) && defined(__SSE2__)
+   __m128i maximum { _mm_set1_epi16((short) colors) };
+
+   for (; index + 8 <= channels; index += 8) {
+      __m128i* lanes { (__m128i*) (channel + index) };
+      _mm_storeu_si128(lanes, _mm_sub_epi16(maximum, _mm_loadu_si128(lanes)));
+   }
+#endif
+
+   negativeScalar(channel + index, channels - index, colors);
+}
+
+#endif // KERNELS_HPP
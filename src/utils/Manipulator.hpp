@@ -15,89 +15,152 @@
 
 #include <iostream>
 #include <fstream>
+#include <glob.h>
+#include <set>
+#include "MappedFile.hpp"
 #include "Manual.hpp"
 #include "Methods.hpp"
+#include "Reader.hpp"
+#include "Streamer.hpp"
+#include "Writer.hpp"
+
+/**
+ * @brief Read an image from the location.
+ *
+ * @param local Image location.
+ * @param[out] image Image memory position.
+ * @return True if the image was read or false if the file could not be
+ * opened or is not valid.
+ * @see Reader
+ */
+bool readImage(std::string local, Image& image) {
+   std::ifstream file(local, std::ios::binary);
+
+   if (!file.is_open()) {
+      return false;
+   }
+
+   Reader reader { file };
+
+   return reader.readImage(image);
+}
 
 /**
    * @brief Open an image from the location and save in image object.
    * 
+   * @details The program stops when the image can not be read.
+   * 
    * @param local Image Location.
    * @param[out] image Image memory position.
+   * @see readImage()
    */
 void openImage(std::string local, Image& image) {
-   std::string type { "" };
-   int width { 0 };
-   int height { 0 };
-   int colors { 0 };
-
-   std::ifstream file(local);
-
-   if (!file.is_open()) {
+   if (!readImage(local, image)) {
       std::cerr << "Reading error!" << std::endl;
       abort();
    }
+}
+
+/**
+ * @brief Write an image in ppm format to an output stream.
+ * 
+ * @param output Output stream.
+ * @param image Image to write.
+ * @see Writer
+ */
+void writePPM(std::ostream& output, Image const& image) {
+   Writer writer { output };
+   writer.writeImage(image);
+}
 
-   file >> type;
-   file >> width;
-   file >> height;
-   file >> colors;
+/**
+ * @brief Write an image in #BINARY_TYPE format to a file mapped to memory.
+ *
+ * @details The size of the file is known from the header and the rows, so
+ * it is allocated at once and the threads of the editor copy bands of
+ * rows straight to their place in the file, with no buffer between them.
+ *
+ * @param local Image location.
+ * @param editor Editor memory position, with an image of #BINARY_TYPE.
+ * @return True if the file was written or false if it could not be mapped.
+ * @see MappedFile
+ * @see Writer::copyBytes()
+ * @see Editor::forEachBand()
+ */
+bool exportMapped(std::string local, Editor& editor) {
+   Image const& image { editor.getImage() };
+   std::string header { Writer::getHeader(image.getType(), image.getWidth(),
+      image.getHeight(), image.getColors()) };
+   size_t row_size { image.getRowSize() };
+   int height { image.getHeight() };
 
-   image.setType(type);
-   image.setSize(width, height);
-   image.setColors(colors);
+   MappedFile file;
 
-   if (type == BINARY_TYPE) {
-      colors = image.getColors();
-      file.ignore();
+   if (!file.open(local, header.size() + row_size * height + 1)) {
+      return false;
    }
 
-   for (int row { 0 }; row < height; row++) {
-      for (int column { 0 }; column < width; column++) {
-         int red { 0 };
-         int green { 0 };
-         int blue { 0 };
-         Pixel pixel;
-         pixel.setColors(colors);
+   unsigned char* data { file.getData() };
+   unsigned char* raster { data + header.size() };
 
-         if (type == ASCII_TYPE) {
-            file >> red >> green >> blue;
+   memcpy(data, header.c_str(), header.size());
 
-            pixel.setRed(red);
-            pixel.setGreen(green);
-            pixel.setBlue(blue);
-         } else {
-            char color;
-
-            file.get(color);
-            pixel.setRed((unsigned char) color);
-            file.get(color);
-            pixel.setGreen((unsigned char) color);
-            file.get(color);
-            pixel.setBlue((unsigned char) color);
-         }
+   editor.forEachBand(height, [&] (int first, int last) {
+      Writer::copyBytes(image, first, last - first,
+         raster + row_size * first);
+   });
 
-         image.setPixel(pixel, row, column);
-      }
+   data[file.getSize() - 1] = '\n';
+
+   return file.close();
+}
+
+/**
+ * @brief Write an image to a location.
+ *
+ * @details The #BINARY_TYPE images are written to a file mapped to memory
+ * when the output can be mapped, and the others go through a stream.
+ *
+ * @param local Image location.
+ * @param editor Editor memory position.
+ * @return True if the image was written or false if it was not.
+ * @see exportMapped()
+ * @see writePPM()
+ */
+bool writeImage(std::string local, Editor& editor) {
+   Image const& image { editor.getImage() };
+
+   if (image.getType() == BINARY_TYPE && exportMapped(local, editor)) {
+      return true;
    }
 
+   std::ofstream file(local, std::ios::binary);
+
+   if (!file.is_open()) {
+      return false;
+   }
+
+   writePPM(file, image);
+   file << '\n';
    file.close();
+
+   return (bool) file;
 }
 
 /**
  * @brief Export image to program output.
+ *
+ * @details The program stops when the image can not be written.
+ *
  * @param local Image location.
  * @param editor Editor memory position.
+ * @see writeImage()
  */
 void exportImage(std::string local, Editor &editor) {
-   std::ofstream file(local);
-
-   if (!file.is_open()) {
+   if (!writeImage(local, editor)) {
       std::cerr << "Writing error!" << std::endl;
       abort();
    }
-
-   file << editor.getImage().toString() << std::endl;
-   file.close();
 }
 
 /**
@@ -125,6 +188,12 @@ bool isDirective(std::string str) {
       return true;
    } else if (str == "-t" || str == "--text") {
       return true;
+   } else if (str == "--batch") {
+      return true;
+   } else if (str == "--stream") {
+      return true;
+   } else if (str == "--threads") {
+      return true;
    }
 
    return false;
@@ -257,16 +326,199 @@ bool getCombineFunction(Editor& editor, Image& foreground,
    return true;
 }
 
+/**
+ * @brief Reads the options of the resize or reduce effect.
+ *
+ * @details The options are "+s, ++size [WIDTH] [HEIGHT]", "+f, ++factor
+ * [FACTOR]" and, for the resize, "+m, ++method [METHOD]". Without a size
+ * or a factor the image is scaled or reduced by 2. A size or a factor that
+ * is not a number, that gives an image below 1 pixel, a resize above
+ * #MAX_WIDTH by #MAX_HEIGHT or a reduction larger than the image, is
+ * reported.
+ * 
+ * @tparam Target Editor or Streamer.
+ * @param editor Editor memory position, with the image to resize or
+ * reduce.
+ * @param effect Effect of the options, #Resize or #Reduce.
+ * @param[in,out] position Position of the effect, moved to the last option
+ * read.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param[out] width Width of the size, or 0.
+ * @param[out] height Height of the size, or 0.
+ * @param[out] factor Factor, or 0 when a size is given.
+ * @param[out] filter Resampling filter.
+ * @param[out] error Message of the size or the factor that is not valid.
+ * @return True if the size or the factor is valid or false if it is not.
+ */
+template <typename Target>
+bool getSizeOptions(Target& editor, Effects effect, int& position, int argc,
+   char* argv[], int& width, int& height, double& factor, Filters& filter,
+   std::string& error)
+{
+   std::string value { "2" };
+   std::string name { "factor " };
+   bool valid { true };
+
+   width = 0;
+   height = 0;
+   factor = 2;
+   filter = Bilinear;
+
+   while (position + 2 < argc) {
+      std::string option { argv[position + 1] };
+
+      try {
+         if ((option == "+s" || option == "++size") && position + 3 < argc)
+         {
+            value = std::string(argv[position + 2]) + " " +
+               argv[position + 3];
+            name = "size ";
+            factor = 0;
+            position += 3;
+            width = std::stoi(argv[position - 1]);
+            height = std::stoi(argv[position]);
+         } else if (option == "+f" || option == "++factor") {
+            value = argv[position + 2];
+            name = "factor ";
+            position += 2;
+            factor = std::stod(argv[position]);
+         } else if (effect == Resize &&
+            (option == "+m" || option == "++method"))
+         {
+            filter = getFilterByName(argv[position + 2]);
+            position += 2;
+         } else {
+            break;
+         }
+      } catch (const std::logic_error&) {
+         valid = false;
+      }
+   }
+
+   /*
+    * The scaled sizes are checked before they are cast to integers, so a
+    * large factor does not overflow.
+    */
+   if (valid && effect == Resize && factor != 0) {
+      valid = factor > 0 &&
+         (editor.getWidth() - 1) * factor < MAX_WIDTH - 1 &&
+         (editor.getHeight() - 1) * factor < MAX_HEIGHT - 1;
+   } else if (valid && effect == Resize) {
+      valid = width >= 1 && height >= 1 && width <= MAX_WIDTH &&
+         height <= MAX_HEIGHT;
+   } else if (valid && factor != 0) {
+      valid = factor >= 1 && factor <= editor.getWidth() &&
+         factor <= editor.getHeight();
+   } else if (valid) {
+      valid = width >= 1 && height >= 1 && width <= editor.getWidth() &&
+         height <= editor.getHeight();
+   }
+
+   if (!valid) {
+      error = "The " + name + value + " is not valid.";
+   }
+
+   return valid;
+}
+
+/**
+ * @brief Reads the options of the resize or reduce effect and runs it.
+ * 
+ * @param editor Editor memory position.
+ * @param effect Effect to run, #Resize or #Reduce.
+ * @param position Position of the effect.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param[out] error Message of the size or the factor that is not valid.
+ * @return The position of the last option read.
+ * @see setResize()
+ * @see setReduce()
+ */
+int getSizeOptions(Editor& editor, Effects effect, int position, int argc,
+   char* argv[], std::string& error)
+{
+   int width { 0 };
+   int height { 0 };
+   double factor { 0 };
+   Filters filter { Bilinear };
+
+   if (!getSizeOptions(editor, effect, position, argc, argv, width, height,
+      factor, filter, error))
+   {
+      return position;
+   }
+
+   if (effect == Resize) {
+      setResize(editor, width, height, factor, filter);
+   } else {
+      setReduce(editor, width, height, factor);
+   }
+
+   return position;
+}
+
+/**
+ * @brief Reads the radius that may follow the blur, e.g. "blur +r 3".
+ *
+ * @details A radius that is not a number, or is below 1, is returned as an
+ * error and the blur is not applied.
+ *
+ * @param[in,out] position Position of the blur, moved to the last option
+ * read.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param[out] error Message of the radius that is not valid.
+ * @return The radius, 1 without the option or 0 when it is not valid.
+ */
+int getRadiusOption(int& position, int argc, char* argv[],
+   std::string& error)
+{
+   if (position + 2 < argc && (std::string(argv[position + 1]) == "+r" ||
+      std::string(argv[position + 1]) == "++radius"))
+   {
+      position += 2;
+
+      try {
+         int radius { std::stoi(argv[position]) };
+
+         if (radius >= 1) {
+            return radius;
+         }
+      } catch (const std::logic_error&) { }
+
+      error = std::string("The radius ") + argv[position] + " is not valid.";
+
+      return 0;
+   }
+
+   return 1;
+}
+
 /**
  * @brief Checks that the effect has been used and runs properly.
+ *
+ * @details Consecutive point-wise and geometric effects are gathered and
+ * each kind is applied in a single pass over the image. The point-wise
+ * effects do not depend on the position of the pixels, so they may be
+ * gathered across the geometric ones, and the other way around.
  * 
+ * An option that is not valid skips its effect, and the first one is
+ * returned in the error.
+ *
  * @param editor Editor memory position.
  * @param argc Number of arguments.
  * @param argv Argument values.
+ * @param[out] error Message of the first option that is not valid.
  * @return An boolean.
  * @see searchString()
+ * @see isPointEffect()
+ * @see isGeometricEffect()
+ * @see getSizeOptions()
  */
-bool getEffectType(Editor& editor, int argc, char* argv[]) {
+bool getEffectType(Editor& editor, int argc, char* argv[],
+   std::string& error)
+{
    int directive_search1 { searchString(argc, argv, "-e") };
    int directive_search2 { searchString(argc, argv, "--effect") };
 
@@ -280,29 +532,166 @@ bool getEffectType(Editor& editor, int argc, char* argv[]) {
       return false;
    }
 
+   std::vector<Effects> point_effects;
+   std::vector<Effects> geometric_effects;
+   std::string option_error;
+
    for (int i { effect_position + 1 }; i < argc; i++) {
       Effects effect { getEffectByName(argv[i]) };
 
-      if (effect != Effect_None) {
-         setEffect(editor, effect);
+      if (isPointEffect(effect)) {
+         point_effects.push_back(effect);
+         continue;
+      } else if (isGeometricEffect(effect)) {
+         geometric_effects.push_back(effect);
+         continue;
+      }
+
+      editor.applyPointEffects(point_effects);
+      editor.applyGeometricEffects(geometric_effects);
+      point_effects.clear();
+      geometric_effects.clear();
+
+      if (effect == Effect_None) {
+         break;
+      }
+
+      if (effect == Resize || effect == Reduce) {
+         i = getSizeOptions(editor, effect, i, argc, argv, option_error);
       } else {
+         setEffect(editor, effect, effect == Blurring ?
+            getRadiusOption(i, argc, argv, option_error) : 1);
+      }
+
+      if (error.empty()) {
+         error = option_error;
+      }
+   }
+
+   editor.applyPointEffects(point_effects);
+   editor.applyGeometricEffects(geometric_effects);
+
+   return true;
+}
+
+/**
+ * @brief Checks that the effect has been used and runs properly, reporting
+ * the first option that is not valid.
+ *
+ * @param editor Editor memory position.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @return An boolean.
+ */
+bool getEffectType(Editor& editor, int argc, char* argv[]) {
+   std::string error;
+   bool used { getEffectType(editor, argc, argv, error) };
+
+   if (!error.empty()) {
+      std::cerr << error << std::endl;
+   }
+
+   return used;
+}
+
+/**
+ * @brief Checks that the effect has been used and records it in the
+ * streamer.
+ *
+ * @details Only the effects that need nearby rows can be streamed: the
+ * point-wise effects, the masks, the blur and the reduction.
+ *
+ * @param streamer Streamer memory position.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @return False if an effect can not be streamed or true otherwise.
+ * @see getEffectType()
+ */
+bool getStreamEffects(Streamer& streamer, int argc, char* argv[]) {
+   int effect_position { searchString(argc, argv, "-e") };
+
+   if (effect_position == -1) {
+      effect_position = searchString(argc, argv, "--effect");
+   }
+
+   if (effect_position == -1) {
+      return true;
+   }
+
+   std::vector<Effects> point_effects;
+
+   for (int i { effect_position + 1 }; i < argc; i++) {
+      Effects effect { getEffectByName(argv[i]) };
+
+      if (isPointEffect(effect)) {
+         point_effects.push_back(effect);
+         continue;
+      }
+
+      streamer.applyPointEffects(point_effects);
+      point_effects.clear();
+
+      if (effect == Effect_None) {
          break;
       }
+
+      std::string error;
+
+      switch (effect) {
+         case Blurring:
+            streamer.blurImage(getRadiusOption(i, argc, argv, error));
+            break;
+         case Edge_Sharpening:
+            streamer.applyImageEffects("edge-sharpening");
+            break;
+         case Embossing:
+            streamer.applyImageEffects("embossing");
+            break;
+         case Sharpening:
+            streamer.applyImageEffects("sharpening");
+            break;
+         case Reduce: {
+            int width { 0 };
+            int height { 0 };
+            double factor { 0 };
+            Filters filter { Bilinear };
+
+            if (getSizeOptions(streamer, effect, i, argc, argv, width,
+               height, factor, filter, error))
+            {
+               setReduce(streamer, width, height, factor);
+            }
+
+            break;
+         }
+         default:
+            std::cerr << "The effect " << argv[i] << " can not be streamed."
+               << std::endl;
+            return false;
+      }
+
+      if (!error.empty()) {
+         std::cerr << error << std::endl;
+      }
    }
 
+   streamer.applyPointEffects(point_effects);
+
    return true;
 }
 
 /**
  * @brief Checks that the border has been used and runs properly.
  * 
+ * @tparam Target Editor or Streamer.
  * @param editor Editor memory position.
  * @param argc Number of arguments.
  * @param argv Argument values.
  * @return An boolean.
  * @see searchString()
  */
-bool getBorderType(Editor& editor, int argc, char* argv[]) {
+template <typename Target>
+bool getBorderType(Target& editor, int argc, char* argv[]) {
    int directive_search1 { searchString(argc, argv, "-b") };
    int directive_search2 { searchString(argc, argv, "--border") };
 
@@ -360,16 +749,39 @@ bool getBorderType(Editor& editor, int argc, char* argv[]) {
 }
 
 /**
- * @brief Checks that the text has been used and runs properly.
+ * @brief Checks that the text has been used and reads it from the input.
+ * 
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param[out] text Text read.
+ * @return An boolean.
+ * @see searchString()
+ */
+bool readText(int argc, char* argv[], std::string& text) {
+   if (searchString(argc, argv, "-t") == -1 &&
+      searchString(argc, argv, "--text") == -1)
+   {
+      return false;
+   }
+
+   std::cout << "Enter a text: ";
+   std::getline(std::cin, text);
+
+   return true;
+}
+
+/**
+ * @brief Checks that the text has been used and writes it properly.
  * 
  * @param editor Editor memory position.
  * @param argc Number of arguments.
  * @param argv Argument values.
+ * @param text Text to write.
  * @return An boolean.
  * @see searchString()
  * @see isDirective()
  */
-bool getText(Editor& editor, int argc, char* argv[]) {
+bool getText(Editor& editor, int argc, char* argv[], std::string text) {
    int directive_search1 { searchString(argc, argv, "-t") };
    int directive_search2 { searchString(argc, argv, "--text") };
 
@@ -400,11 +812,6 @@ bool getText(Editor& editor, int argc, char* argv[]) {
       }
    }
 
-   std::string text;
-
-   std::cout << "Enter a text: ";
-   std::getline(std::cin, text);
-
    int position_x { 0 };
    int position_y { 0 };
 
@@ -431,15 +838,46 @@ bool getText(Editor& editor, int argc, char* argv[]) {
    return true;
 }
 
+/**
+ * @brief Checks that the text has been used and writes a text read from
+ * the input.
+ * 
+ * @param editor Editor memory position.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @return An boolean.
+ * @see readText()
+ */
+bool getText(Editor& editor, int argc, char* argv[]) {
+   std::string text;
+
+   if (!readText(argc, argv, text)) {
+      return false;
+   }
+
+   /*
+    * The fonts are read when they are first used, and a single image can
+    * not be written without its font.
+    */
+   try {
+      return getText(editor, argc, argv, text);
+   } catch (std::runtime_error const& error) {
+      std::cerr << error.what() << std::endl;
+      abort();
+   }
+}
+
 /**
  * @brief Checks that the convert has been used and runs properly.
+ * @tparam Target Editor or Streamer.
  * @param editor Editor memory position.
  * @param argc Number of arguments.
  * @param argv Argument values.
  * @return An boolean.
  * @see searchString()
  */
-bool getConvertType(Editor& editor, int argc, char* argv[]) {
+template <typename Target>
+bool getConvertType(Target& editor, int argc, char* argv[]) {
    int convert_search { searchString(argc, argv, "--convert") };
    
    if (convert_search == -1) {
@@ -453,6 +891,57 @@ bool getConvertType(Editor& editor, int argc, char* argv[]) {
    return true;
 }
 
+/**
+ * @brief Checks that the threads have been set and reads them.
+ *
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param[out] threads Threads read, left unchanged without the option or
+ * with a number that is not valid.
+ * @return An boolean.
+ * @see searchString()
+ */
+bool getThreadsNumber(int argc, char* argv[], int& threads) {
+   int threads_search { searchString(argc, argv, "--threads") };
+
+   if (threads_search == -1 || threads_search + 1 >= argc) {
+      return false;
+   }
+
+   try {
+      threads = std::stoi(argv[threads_search + 1]);
+   } catch (const std::logic_error&) {
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * @brief Checks that the threads have been set and sets them in the editor.
+ *
+ * @details Without the option, or with a number that is not valid, the
+ * editor keeps its default threads.
+ *
+ * @tparam Target Editor or Streamer.
+ * @param editor Editor memory position.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @return An boolean.
+ */
+template <typename Target>
+bool getThreadsNumber(Target& editor, int argc, char* argv[]) {
+   int threads { 0 };
+
+   if (!getThreadsNumber(argc, argv, threads)) {
+      return false;
+   }
+
+   editor.setThreads(threads);
+
+   return true;
+}
+
 /**
  * @brief Opens the images and returns the total amount.
  * 
@@ -518,4 +1007,308 @@ std::string getOutputFile(int argc, char* argv[]) {
    return output_local;
 }
 
+/**
+ * @brief Edits the input image in bands, straight from its file to the
+ * output file.
+ *
+ * @details The option is "--stream [ROWS]", with the rows of each band.
+ * The memory grows with the width of the image times the rows, so images
+ * larger than the memory can be edited. The combination and the text need
+ * the whole image and can not be streamed.
+ *
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @return True if the image was written or false if it was not.
+ * @see Streamer
+ * @see getStreamEffects()
+ */
+bool streamImage(int argc, char* argv[]) {
+   int stream_position { searchString(argc, argv, "--stream") };
+   int rows { STREAM_BAND_ROWS };
+
+   if (stream_position + 1 < argc &&
+      !isDirective(argv[stream_position + 1]))
+   {
+      try {
+         rows = std::stoi(argv[stream_position + 1]);
+      } catch (const std::logic_error&) { }
+   }
+
+   if (searchString(argc, argv, "-c") != -1 ||
+      searchString(argc, argv, "--combine") != -1 ||
+      searchString(argc, argv, "-t") != -1 ||
+      searchString(argc, argv, "--text") != -1)
+   {
+      std::cerr << "The combine and the text can not be streamed."
+         << std::endl;
+      return false;
+   }
+
+   int input_position { searchString(argc, argv, "-i") };
+
+   if (input_position == -1) {
+      input_position = searchString(argc, argv, "--input");
+   }
+
+   std::ifstream input(argv[input_position + 1], std::ios::binary);
+   Streamer streamer { input, rows };
+
+   if (!input.is_open() || !streamer.readHeader()) {
+      std::cerr << "Reading error!" << std::endl;
+      return false;
+   }
+
+   getThreadsNumber(streamer, argc, argv);
+
+   if (!getStreamEffects(streamer, argc, argv)) {
+      return false;
+   }
+
+   getBorderType(streamer, argc, argv);
+   getConvertType(streamer, argc, argv);
+
+   std::ofstream output(getOutputFile(argc, argv), std::ios::binary);
+
+   if (!output.is_open()) {
+      std::cerr << "Writing error!" << std::endl;
+      return false;
+   }
+
+   if (!streamer.writeImage(output)) {
+      std::cerr << "Reading error!" << std::endl;
+      return false;
+   }
+
+   output << '\n';
+
+   return true;
+}
+
+/**
+ * @brief Gets the input files of a batch.
+ *
+ * @details The inputs are all the arguments after the input directive,
+ * until the next directive. An input with "*", "?" or "[" is a pattern,
+ * expanded here in sorted order, so it may be quoted to pass more files
+ * than the shell accepts. A pattern with no match is kept as it is and
+ * fails as a file. An input that starts with "@" is a list of files, one
+ * per line, taken as they are.
+ *
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param inputs The input files, in order.
+ * @return True if all lists were read or false if some was not.
+ * @see isDirective()
+ */
+bool getInputList(int argc, char* argv[], std::vector<std::string>& inputs)
+{
+   int input_position { searchString(argc, argv, "-i") };
+
+   if (input_position == -1) {
+      input_position = searchString(argc, argv, "--input");
+   }
+
+   for (int i { input_position + 1 }; i < argc && !isDirective(argv[i]);
+      i++)
+   {
+      std::string input { argv[i] };
+
+      if (input.find_first_of("*?[") != std::string::npos) {
+         glob_t paths;
+
+         if (glob(input.c_str(), 0, nullptr, &paths) == 0) {
+            inputs.insert(inputs.end(), paths.gl_pathv,
+               paths.gl_pathv + paths.gl_pathc);
+         } else {
+            inputs.push_back(input);
+         }
+
+         globfree(&paths);
+         continue;
+      }
+
+      if (input.empty() || input[0] != '@') {
+         inputs.push_back(input);
+         continue;
+      }
+
+      std::ifstream list(input.substr(1));
+      std::string line;
+
+      if (!list.is_open()) {
+         std::cerr << "Reading error! " << input.substr(1) << std::endl;
+         return false;
+      }
+
+      while (std::getline(list, line)) {
+         if (!line.empty()) {
+            inputs.push_back(line);
+         }
+      }
+   }
+
+   return true;
+}
+
+/**
+ * @brief Gets the output file of an input of a batch.
+ *
+ * @details An output with "%" is a template, where it is replaced by the
+ * name of the input without its extension. Any other output is a
+ * directory, where the input keeps its name.
+ *
+ * @param output Output template or directory.
+ * @param input Input file.
+ * @return An string.
+ */
+std::string getBatchOutput(std::string output, std::string input) {
+   std::string name { input.substr(input.find_last_of('/') + 1) };
+   size_t percent { output.find('%') };
+
+   if (percent != std::string::npos) {
+      return output.replace(percent, 1, name.substr(0, name.rfind('.')));
+   }
+
+   if (!output.empty() && output.back() != '/') {
+      output += '/';
+   }
+
+   return output + name;
+}
+
+/**
+ * @brief Edits an image of a batch and writes it.
+ *
+ * @details The errors of the image, exceptions included, are returned
+ * instead of stopping the batch, e.g. a header too large for the memory
+ * or a size that is not valid for the image. An image with an option that
+ * is not valid is not written.
+ *
+ * @param input Input file.
+ * @param output Output file.
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @param text Text written when the text directive is used.
+ * @return An empty string, or the error found.
+ */
+std::string editBatchImage(std::string input, std::string output, int argc,
+   char* argv[], std::string const& text)
+{
+   try {
+      Image image;
+
+      if (!readImage(input, image)) {
+         return "Reading error!";
+      }
+
+      Editor editor { std::move(image) };
+      editor.setThreads(1);
+
+      std::string error;
+      getEffectType(editor, argc, argv, error);
+
+      if (!error.empty()) {
+         return error;
+      }
+
+      getBorderType(editor, argc, argv);
+      getText(editor, argc, argv, text);
+      getConvertType(editor, argc, argv);
+
+      if (!writeImage(output, editor)) {
+         return "Writing error!";
+      }
+   } catch (std::runtime_error const& error) {
+      return error.what();
+   } catch (std::logic_error const& error) {
+      return std::string("Invalid option: ") + error.what();
+   } catch (std::exception const& error) {
+      return std::string("Editing error! ") + error.what();
+   }
+
+   return "";
+}
+
+/**
+ * @brief Edits many images with the same directives in a single process.
+ *
+ * @details The option is "--batch" and the inputs are taken by
+ * getInputList(). The output directive is a directory or a template of
+ * the outputs, "%-edited.ppm" by default. The images are spread among the
+ * threads, each reading, editing and writing its images, so the reading
+ * and the writing of some images overlap the editing of others. An image
+ * whose output is the output of a previous image is not edited. The
+ * errors are reported for each image, after all of them.
+ *
+ * @param argc Number of arguments.
+ * @param argv Argument values.
+ * @return True if all images were written or false if some was not.
+ * @see editBatchImage()
+ * @see getBatchOutput()
+ */
+bool batchImages(int argc, char* argv[]) {
+   if (searchString(argc, argv, "-c") != -1 ||
+      searchString(argc, argv, "--combine") != -1)
+   {
+      std::cerr << "The combine can not be used in a batch." << std::endl;
+      return false;
+   }
+
+   std::vector<std::string> inputs;
+
+   if (!getInputList(argc, argv, inputs)) {
+      return false;
+   }
+
+   std::string output { "%-edited.ppm" };
+
+   if (searchString(argc, argv, "-o") != -1 ||
+      searchString(argc, argv, "--output") != -1)
+   {
+      output = getOutputFile(argc, argv);
+   }
+
+   std::string text;
+   readText(argc, argv, text);
+
+   int threads { ThreadPool::getDefaultThreads() };
+   getThreadsNumber(argc, argv, threads);
+
+   std::vector<std::string> outputs(inputs.size());
+   std::vector<std::string> errors(inputs.size());
+   std::set<std::string> names;
+
+   for (size_t index { 0 }; index < inputs.size(); index++) {
+      outputs[index] = getBatchOutput(output, inputs[index]);
+
+      if (!names.insert(outputs[index]).second) {
+         errors[index] = "Duplicate output: " + outputs[index];
+      }
+   }
+
+   ThreadPool pool { std::min(threads, (int) inputs.size()) };
+
+   pool.run((int) inputs.size(), [&] (int index) {
+      if (errors[index].empty()) {
+         errors[index] = editBatchImage(inputs[index], outputs[index], argc,
+            argv, text);
+      }
+   });
+
+   size_t written { 0 };
+
+   for (size_t index { 0 }; index < inputs.size(); index++) {
+      if (errors[index].empty()) {
+         written++;
+      } else {
+         std::cerr << inputs[index] << ": " << errors[index] << std::endl;
+      }
+   }
+
+   std::cout << "Edited " << written << " of " << inputs.size()
+      << " images." << std::endl;
+
+   return written == inputs.size();
+}
+
 #endif // MANIPULATOR_HPP
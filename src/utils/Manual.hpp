@@ -26,6 +26,8 @@ void printManual() {
 		<< "\n\n";
 
 	std::cout << "Options:\n";
+	std::cout << "  --batch: Edit all the input images with the same options, the "
+		<< "output being a directory or a name with %\n";
 	std::cout << "  -b, --border [OPTIONS]: Add a border to the image\n";
 	std::cout << "  -c, --combine [OPTIONS]: Combines two images\n";
 	std::cout << "  --convert: Convert the image to another format\n";
@@ -33,10 +35,15 @@ void printManual() {
 	std::cout << "  -h, --help [OPTIONS]: Display this Manual manual\n";
 	std::cout << "  -i, --input [INPUT_FILES]: Specify input image(s)\n";
 	std::cout << "  -o, --output [OUTPUT_FILE]: Specify output image\n" ;
-	std::cout << "  -t, --text [OPTIONS]: Add text to the image\n\n";
+	std::cout << "  --stream [ROWS]: Edit the image in bands of rows, for images "
+		<< "larger than the memory\n";
+	std::cout << "  -t, --text [OPTIONS]: Add text to the image\n";
+	std::cout << "  --threads [THREADS]: Set the threads of the filters\n\n";
 	
 	std::cout << "Defaults:\n";
-	std::cout << "  Output file: a.ppm\n\n";
+	std::cout << "  Output file: a.ppm\n";
+	std::cout << "  Stream rows: 256\n";
+	std::cout << "  Threads: All the hardware threads\n\n";
 	
 	std::cout << "Example:\n";
 	std::cout << "  ppmedit -b polaroid -i input1.ppm -o output.ppm\n";
@@ -127,20 +134,42 @@ void printEffectManual() {
 	std::cout << "  rotate: Rotate the image clockwise by 90 degrees\n";
 	std::cout << "  rotate-l: Rotate the image counter-clockwise by 90 "
 		<< "degrees\n";
+	std::cout << "  rotate-h: Rotate the image by 180 degrees\n";
 	std::cout << "  invert: Invert the colors of the image\n";
+	std::cout << "  flip: Flip the image upside down\n";
 	std::cout << "  enlarge: Enlarge the image (2x)\n";
-	std::cout << "  reduce: Reduce the image (2x)\n";
+	std::cout << "  reduce: Reduce the image averaging its pixels (2x)\n";
+	std::cout << "  resize: Resize the image to any size\n";
 	std::cout << "  sharp: Apply a sharpening effect to the image\n";
 	std::cout << "  sharp-e: Apply an edge sharpening effect to the image\n";
 	std::cout << "  blur: Apply a blur effect to the image\n";
 	std::cout << "  embossing: Apply an embossing effect to the image\n\n";
 
+	std::cout << "Blur options:\n";
+	std::cout << "  +r, ++radius [RADIUS]: Sets the radius of the blur "
+		<< "(default: 1)\n\n";
+
+	std::cout << "Reduce options:\n";
+	std::cout << "  +s, ++size [WIDTH] [HEIGHT]: Sets the size of the image\n";
+	std::cout << "  +f, ++factor [FACTOR]: Reduces the image by the factor "
+		<< "(default: 2)\n\n";
+
+	std::cout << "Resize options:\n";
+	std::cout << "  +s, ++size [WIDTH] [HEIGHT]: Sets the size of the image\n";
+	std::cout << "  +f, ++factor [FACTOR]: Scales the image by the factor "
+		<< "(default: 2)\n";
+	std::cout << "  +m, ++method [METHOD]: Sets the filter, nearest, "
+		<< "bilinear or bicubic (default: bilinear)\n\n";
+
 	std::cout << "Defaults:\n";
 	std::cout << "  No effect is applied\n\n";
 
 	std::cout << "Example:\n";
 	std::cout << "  ppmedit -e gray negative rotate -i input.ppm -o "
 		<< "output.ppm\n";
+	std::cout << "  ppmedit -e blur +r 5 gray -i input.ppm -o output.ppm\n";
+	std::cout << "  ppmedit -e resize +f 3 +m bicubic -i input.ppm -o "
+		<< "output.ppm\n";
 }
 
 /**
@@ -70,16 +70,44 @@ void setCombine(Editor& editor, Image& foreground, std::string position) {
    setCombine(editor, foreground, x, y);
 }
 
+/**
+ * @brief Checks if an effect changes each pixel on its own.
+ *
+ * @details Runs of these effects are applied together by
+ * Editor::applyPointEffects().
+ *
+ * @param type Effect to check.
+ * @return An boolean.
+ */
+bool isPointEffect(Effects type) {
+   return type == Gray || type == Negative;
+}
+
+/**
+ * @brief Checks if an effect only rotates or mirrors the image.
+ *
+ * @details Runs of these effects are applied together by
+ * Editor::applyGeometricEffects().
+ *
+ * @param type Effect to check.
+ * @return An boolean.
+ */
+bool isGeometricEffect(Effects type) {
+   return type == Rotate_Right || type == Rotate_Left ||
+      type == Rotate_Half || type == Invert || type == Flip;
+}
+
 /**
  * @brief Executes the effect method in the editor.
  * 
  * @param editor Editor memory position.
  * @param type Effect to apply.
+ * @param radius Radius of the blur. Default is 1.
  */
-void setEffect(Editor& editor, Effects type) {
+void setEffect(Editor& editor, Effects type, int radius = 1) {
    switch(type) {
       case Blurring:
-         editor.applyImageEffects("blurring");
+         editor.blurImage(radius);
          break;
       case Edge_Sharpening:
          editor.applyImageEffects("edge-sharpening");
@@ -90,6 +118,9 @@ void setEffect(Editor& editor, Effects type) {
       case Enlarge:
          editor.enlargeImage();
          break;
+      case Flip:
+         editor.rotateImage("flip");
+         break;
       case Gray:
          editor.grayscaleImage();
          break;
@@ -102,6 +133,9 @@ void setEffect(Editor& editor, Effects type) {
       case Reduce:
          editor.reduceImage();
          break;
+      case Rotate_Half:
+         editor.rotateImage("half");
+         break;
       case Rotate_Left:
          editor.rotateImage("left");
          break;
@@ -116,6 +150,43 @@ void setEffect(Editor& editor, Effects type) {
    }
 }
 
+/**
+ * @brief Resize the image in the editor.
+ * 
+ * @param editor Editor memory position.
+ * @param width Width of the resized image, used when the factor is 0.
+ * @param height Height of the resized image, used when the factor is 0.
+ * @param factor Factor of the scale, or 0 to use the size.
+ * @param filter Resampling filter.
+ */
+void setResize(Editor& editor, int width, int height, double factor,
+   Filters filter)
+{
+   if (factor > 0) {
+      editor.scaleImage(factor, filter);
+   } else {
+      editor.resizeImage(width, height, filter);
+   }
+}
+
+/**
+ * @brief Reduce the image in the editor.
+ * 
+ * @tparam Target Editor or Streamer.
+ * @param editor Editor memory position.
+ * @param width Width of the reduced image, used when the factor is 0.
+ * @param height Height of the reduced image, used when the factor is 0.
+ * @param factor Factor of the reduction, or 0 to use the size.
+ */
+template <typename Target>
+void setReduce(Target& editor, int width, int height, double factor) {
+   if (factor > 0) {
+      editor.reduceImage(factor);
+   } else {
+      editor.reduceImage(width, height);
+   }
+}
+
 /**
  * @brief Get the border size.
  * 
@@ -169,6 +240,7 @@ int getBorderSize(std::string size, int image_width, int image_height) {
  * std::string or int.
  * 
  * @tparam T Type of border size.
+ * @tparam Target Editor or Streamer.
  * @param editor Editor memory position.
  * @param type Border to apply.
  * @param size Border size.
@@ -178,12 +250,13 @@ int getBorderSize(std::string size, int image_width, int image_height) {
  */
 template <
    typename T,
+   typename Target,
    typename = typename std::enable_if<
       std::is_same<T, std::string>::value || 
       std::is_same<T, int>::value
    >::type
 >
-void setBorder(Editor& editor, Borders type, T size,
+void setBorder(Target& editor, Borders type, T size,
    int extra_size, std::string color) 
 {
    Pixel color_pixel { getColorByName(color) };
@@ -228,7 +301,7 @@ void setText(Editor& editor, std::string text, int x, int y,
    for (auto c : text) {
       if (c == ' ') {
          Pair<TypeText, std::string> pair { getTypeByText(word), word };
-         mapped_text.push_back(pair);
+         mapped_text.push_back(std::move(pair));
 
          word = "";
       } else {
@@ -238,7 +311,7 @@ void setText(Editor& editor, std::string text, int x, int y,
 
    if (word != "") {
       Pair<TypeText, std::string> pair { getTypeByText(word), word };
-      mapped_text.push_back(pair);
+      mapped_text.push_back(std::move(pair));
    }
 
    editor.writeText(mapped_text, x, y, font);
@@ -247,10 +320,12 @@ void setText(Editor& editor, std::string text, int x, int y,
 /**
  * @brief Performs image conversion.
  * 
+ * @tparam Target Editor or Streamer.
  * @param editor Editor memory position.
  * @param type Type to convert.
  */
-void performConversion(Editor& editor, Types type) {
+template <typename Target>
+void performConversion(Target& editor, Types type) {
    if (type == Text) {
       editor.convertImage(ASCII_TYPE);
    } else if (type == Binary) {
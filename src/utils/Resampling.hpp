@@ -0,0 +1,711 @@
+/**
+ * @file Resampling.hpp
+ * @author Pedro Lucas (pedrolucas.jsrn@gmail.com)
+ * @brief Resampling functions.
+ * @version 2.0
+ * @date 2023-07-18
+ *
+ * Separable resampling of images to any size with the nearest, bilinear
+ * and bicubic filters. The taps of each output column and row are
+ * computed once, as neighbors and fixed-point weights, then the rows are
+ * resampled across and the result down, rounding each pass. Reductions
+ * average the areas of the boxes of pixels covered by each output
+ * instead.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef RESAMPLING_HPP
+#define RESAMPLING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "Enums.hpp"
+#include "Format.hpp"
+#include "Kernels.hpp"
+#include "Pixel.hpp"
+
+#define RESAMPLE_BITS 14                 /**< Fraction bits of the weights */
+#define RESAMPLE_ONE (1 << RESAMPLE_BITS) /**< Weight of a whole neighbor */
+#define RESAMPLE_HALF (RESAMPLE_ONE / 2) /**< Bias that rounds the sums */
+#define CUBIC_SHARPNESS -0.5             /**< Parameter of the cubic filter */
+#define AREA_UNITS 1000                  /**< Most parts of a pixel of areas */
+
+/**
+ * @struct Taps struct.
+ * @brief Neighbors and weights of each output position of an axis.
+ *
+ * @details The neighbors are stored tap after tap, so the same tap of
+ * consecutive positions is contiguous. The neighbors outside the input are
+ * taken from the nearest edge and the weights of a position always sum
+ * #RESAMPLE_ONE. The sums start from a bias, so they are rounded when
+ * their fraction bits are dropped.
+ */
+struct Taps {
+   int count { 0 };          /**< Neighbors of each position */
+   int size { 0 };           /**< Output positions */
+   int inner { 0 };          /**< Positions before the last input is used */
+   int bias { 0 };           /**< Start of the sums of each position */
+   std::vector<int> indices; /**< Neighbors of each tap */
+   std::vector<int> weights; /**< Weights of each tap */
+};
+
+/**
+ * @brief Get the weight of the cubic filter at a distance.
+ *
+ * @param distance Distance between the neighbor and the position.
+ * @return The weight, zero from a distance of 2.
+ */
+double getCubicWeight(double distance) {
+   double x { std::fabs(distance) };
+   double a { CUBIC_SHARPNESS };
+
+   if (x <= 1) {
+      return ((a + 2) * x - (a + 3)) * x * x + 1;
+   } else if (x < 2) {
+      return ((a * x - 5 * a) * x + 8 * a) * x - 4 * a;
+   }
+
+   return 0;
+}
+
+/**
+ * @brief Get the taps of an axis.
+ *
+ * @details The first and the last outputs are on the first and the last
+ * inputs and the others are evenly spaced between them, so an output of
+ * 2 * input - 1 positions lands on the inputs and on their midpoints.
+ *
+ * @param input Positions of the input.
+ * @param output Positions of the output.
+ * @param filter Resampling filter.
+ * @param truncate Whether the sums are truncated instead of rounded, as
+ * in the enlargement of the editor. Default is false.
+ * @return The taps.
+ */
+Taps getTaps(int input, int output, Filters filter, bool truncate = false) {
+   Taps taps;
+   taps.count = filter == Bicubic ? 4 : filter == Bilinear ? 2 : 1;
+   taps.size = output;
+   taps.bias = truncate ? 0 : RESAMPLE_HALF;
+   taps.indices.resize(taps.count * output);
+   taps.weights.resize(taps.count * output);
+
+   int64_t steps { std::max(output - 1, 1) };
+   int64_t span { output > 1 ? input - 1 : 0 };
+
+   for (int position { 0 }; position < output; position++) {
+      /*
+       * The output lands between the inputs base and base + 1, at the
+       * fraction remainder / steps of the way.
+       */
+      int base { (int) (position * span / steps) };
+      int64_t remainder { position * span % steps };
+      double fraction { (double) remainder / steps };
+
+      int weights[4] = { RESAMPLE_ONE, 0, 0, 0 };
+      int first { base };
+
+      if (filter == Nearest) {
+         first = base + (2 * remainder >= steps ? 1 : 0);
+      } else if (filter == Bilinear) {
+         weights[1] = (int) ((2 * remainder * RESAMPLE_ONE + steps)
+            / (2 * steps));
+         weights[0] = RESAMPLE_ONE - weights[1];
+      } else {
+         int sum { 0 };
+         int largest { 0 };
+         first = base - 1;
+
+         for (int tap { 0 }; tap < 4; tap++) {
+            weights[tap] = (int) std::floor(RESAMPLE_ONE
+               * getCubicWeight(tap - 1 - fraction) + 0.5);
+            sum += weights[tap];
+            largest = weights[tap] > weights[largest] ? tap : largest;
+         }
+
+         weights[largest] += RESAMPLE_ONE - sum;
+      }
+
+      for (int tap { 0 }; tap < taps.count; tap++) {
+         int index { std::min(std::max(first + tap, 0), input - 1) };
+
+         taps.indices[tap * output + position] = index;
+         taps.weights[tap * output + position] = weights[tap];
+      }
+
+      /*
+       * The neighbors never move back, so the last tap is the first to
+       * reach the last input.
+       */
+      if (first + taps.count - 1 < input - 1) {
+         taps.inner = position + 1;
+      }
+   }
+
+   return taps;
+}
+
+/**
+ * @struct Areas struct.
+ * @brief Inputs and weights of each output position of an axis when the
+ * areas are averaged.
+ *
+ * @details Each output covers a box of consecutive inputs, the first and
+ * the last of them possibly in part. The weights are the parts of the
+ * inputs in the box, so the weights of a position always sum #total.
+ */
+struct Areas {
+   int64_t total { 0 };      /**< Weight of a whole box */
+   bool whole { false };     /**< Boxes of whole pixels, all of weight 1 */
+   std::vector<int> first;   /**< First input of each position */
+   std::vector<int> offsets; /**< First weight of each position, and the end */
+   std::vector<int> weights; /**< Weights, position after position */
+};
+
+/**
+ * @brief Get the areas of an axis from the boxes of its outputs.
+ *
+ * @param output Positions of the output.
+ * @param length Length of each box, in parts of a pixel.
+ * @param unit Parts of a pixel.
+ * @return The areas.
+ */
+Areas getAreas(int output, int64_t length, int64_t unit) {
+   int64_t a { length };
+   int64_t b { unit };
+
+   while (b != 0) {
+      int64_t rest { a % b };
+      a = b;
+      b = rest;
+   }
+
+   length /= a;
+   unit /= a;
+
+   Areas areas;
+   areas.total = length;
+   areas.whole = unit == 1;
+
+   for (int position { 0 }; position < output; position++) {
+      int64_t start { position * length };
+      int64_t end { start + length };
+      int64_t input { start / unit };
+
+      areas.first.push_back((int) input);
+      areas.offsets.push_back((int) areas.weights.size());
+
+      for (; input * unit < end; input++) {
+         areas.weights.push_back((int) (std::min(end, (input + 1) * unit)
+            - std::max(start, input * unit)));
+      }
+   }
+
+   areas.offsets.push_back((int) areas.weights.size());
+
+   return areas;
+}
+
+/**
+ * @brief Get the areas of an axis reduced to a number of positions.
+ *
+ * @param input Positions of the input.
+ * @param output Positions of the output, from 1 to the input.
+ * @return The areas, covering the whole input.
+ */
+Areas getAreasBySize(int input, int output) {
+   return getAreas(output, input, output);
+}
+
+/**
+ * @brief Get the areas of an axis reduced by a factor.
+ *
+ * @details Each box is as long as the factor, taken as the nearest
+ * fraction with up to #AREA_UNITS parts of a pixel, and the inputs after
+ * the last whole box are left out, so a factor of 2 drops the last odd
+ * input.
+ *
+ * @param input Positions of the input.
+ * @param factor Factor of the reduction, from 1 to the input, so its
+ * parts fit an integer.
+ * @return The areas.
+ */
+Areas getAreasByFactor(int input, double factor) {
+   int64_t unit { 1 };
+
+   while (unit < AREA_UNITS && std::fabs(factor * unit
+      - std::floor(factor * unit + 0.5)) > 1e-6 * unit)
+   {
+      unit++;
+   }
+
+   int64_t length { (int64_t) std::floor(factor * unit + 0.5) };
+
+   return getAreas((int) (input * unit / length), length, unit);
+}
+
+/**
+ * @brief Get the areas of some consecutive positions of an axis.
+ *
+ * @details The inputs are counted from the first input of the first
+ * position, so the slice reduces only the inputs that it covers.
+ *
+ * @param areas Areas of the whole axis.
+ * @param first First position of the slice.
+ * @param last Position after the last of the slice.
+ * @return The areas of the slice.
+ */
+Areas getAreasSlice(Areas const& areas, int first, int last) {
+   Areas slice;
+   slice.total = areas.total;
+   slice.whole = areas.whole;
+
+   for (int position { first }; position < last; position++) {
+      slice.first.push_back(areas.first[position] - areas.first[first]);
+      slice.offsets.push_back(areas.offsets[position]
+         - areas.offsets[first]);
+   }
+
+   slice.offsets.push_back(areas.offsets[last] - areas.offsets[first]);
+   slice.weights.assign(areas.weights.begin() + areas.offsets[first],
+      areas.weights.begin() + areas.offsets[last]);
+
+   return slice;
+}
+
+/**
+ * @brief Take a weighted sum back to a channel.
+ *
+ * @param sum Sum of the neighbors times their weights, from the bias of
+ * the taps.
+ * @param colors Maximum of colors per pixel channel.
+ * @return The sum without the fraction bits, limited to the colors.
+ */
+inline int getResampledChannel(int sum, int colors) {
+   int value { sum < 0 ? 0 : sum >> RESAMPLE_BITS };
+   return value > colors ? colors : value;
+}
+
+/**
+ * @brief Resample a row of pixels across with a fixed number of taps.
+ *
+ * @tparam Count Neighbors of each position of the taps.
+ * @tparam Channel Type of a single channel.
+ * @param source First channel of the input row.
+ * @param taps Taps of the columns.
+ * @param column First column to resample.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ */
+template <int Count, typename Channel>
+void resampleRowTaps(Channel const* source, Taps const& taps, int column,
+   int colors, Channel* destination)
+{
+   for (; column < taps.size; column++) {
+      int red { taps.bias };
+      int green { taps.bias };
+      int blue { taps.bias };
+
+      for (int tap { 0 }; tap < Count; tap++) {
+         int index { tap * taps.size + column };
+         int weight { taps.weights[index] };
+         Channel const* pixel {
+            source + taps.indices[index] * CHANNELS_PER_PIXEL
+         };
+
+         red += pixel[0] * weight;
+         green += pixel[1] * weight;
+         blue += pixel[2] * weight;
+      }
+
+      Channel* output { destination + column * CHANNELS_PER_PIXEL };
+
+      output[0] = (Channel) getResampledChannel(red, colors);
+      output[1] = (Channel) getResampledChannel(green, colors);
+      output[2] = (Channel) getResampledChannel(blue, colors);
+   }
+}
+
+#if defined(KERNELS_X86)
+/**
+ * @brief Resample a row of pixels across with AVX2, 8 pixels at a time.
+ *
+ * @details The pixels of each tap are gathered as 4 bytes from their first
+ * channel, so only the positions before the last input is used are
+ * resampled.
+ *
+ * @tparam Count Neighbors of each position of the taps.
+ * @param source First channel of the input row.
+ * @param taps Taps of the columns.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ * @return Number of pixels resampled, a multiple of 8.
+ */
+template <int Count>
+__attribute__((target("avx2")))
+int resampleRowAVX2(RGB8::Channel const* source, Taps const& taps,
+   int colors, RGB8::Channel* destination)
+{
+   /*
+    * Drops the fourth byte of each pixel.
+    */
+   __m256i const pack { _mm256_setr_epi8(
+      0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+      0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1) };
+   __m256i const mask { _mm256_set1_epi32(0xFF) };
+   __m256i const zero { _mm256_setzero_si256() };
+   __m256i const maximum { _mm256_set1_epi32(colors) };
+   __m256i const bias { _mm256_set1_epi32(taps.bias) };
+
+   int column { 0 };
+
+   for (; column + 8 <= taps.inner; column += 8) {
+      __m256i red { bias };
+      __m256i green { bias };
+      __m256i blue { bias };
+
+      for (int tap { 0 }; tap < Count; tap++) {
+         int index { tap * taps.size + column };
+         __m256i neighbors { _mm256_loadu_si256(
+            (__m256i const*) &taps.indices[index]) };
+         __m256i weights { _mm256_loadu_si256(
+            (__m256i const*) &taps.weights[index]) };
+
+         __m256i pixels { _mm256_i32gather_epi32((int const*) source,
+            _mm256_add_epi32(neighbors, _mm256_slli_epi32(neighbors, 1)),
+            1) };
+
+         /*
+          * The weights fit in 16 bits, so each product is a single
+          * multiply-add of a channel and a weight.
+          */
+         red = _mm256_add_epi32(red, _mm256_madd_epi16(
+            _mm256_and_si256(pixels, mask), weights));
+         green = _mm256_add_epi32(green, _mm256_madd_epi16(
+            _mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask), weights));
+         blue = _mm256_add_epi32(blue, _mm256_madd_epi16(
+            _mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask), weights));
+      }
+
+      red = _mm256_min_epi32(_mm256_max_epi32(
+         _mm256_srai_epi32(red, RESAMPLE_BITS), zero), maximum);
+      green = _mm256_min_epi32(_mm256_max_epi32(
+         _mm256_srai_epi32(green, RESAMPLE_BITS), zero), maximum);
+      blue = _mm256_min_epi32(_mm256_max_epi32(
+         _mm256_srai_epi32(blue, RESAMPLE_BITS), zero), maximum);
+
+      __m256i pixels { _mm256_shuffle_epi8(_mm256_or_si256(red,
+         _mm256_or_si256(_mm256_slli_epi32(green, 8),
+         _mm256_slli_epi32(blue, 16))), pack) };
+
+      RGB8::Channel* output { destination + column * CHANNELS_PER_PIXEL };
+      __m128i high { _mm256_extracti128_si256(pixels, 1) };
+      int last { _mm_extract_epi32(high, 2) };
+
+      _mm_storeu_si128((__m128i*) output, _mm256_castsi256_si128(pixels));
+      _mm_storel_epi64((__m128i*) (output + 12), high);
+      memcpy(output + 20, &last, sizeof(last));
+   }
+
+   return column;
+}
+
+/**
+ * @brief Widen 8 channels into 32 bits lanes with AVX2.
+ *
+ * @param channel First channel.
+ * @return The lanes.
+ */
+__attribute__((target("avx2")))
+inline __m256i widenAVX2(RGB8::Channel const* channel) {
+   return _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const*) channel));
+}
+
+/**
+ * @brief Widen 8 channels into 32 bits lanes with AVX2.
+ *
+ * @param channel First channel.
+ * @return The lanes.
+ */
+__attribute__((target("avx2")))
+inline __m256i widenAVX2(RGB16::Channel const* channel) {
+   return _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const*) channel));
+}
+
+/**
+ * @brief Store 16 channels of 16 bits lanes with AVX2.
+ *
+ * @param lanes Channels.
+ * @param destination First channel of the output.
+ */
+__attribute__((target("avx2")))
+inline void storeAVX2(__m256i lanes, RGB8::Channel* destination) {
+   _mm_storeu_si128((__m128i*) destination, _mm_packus_epi16(
+      _mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1)));
+}
+
+/**
+ * @brief Store 16 channels of 16 bits lanes with AVX2.
+ *
+ * @param lanes Channels.
+ * @param destination First channel of the output.
+ */
+__attribute__((target("avx2")))
+inline void storeAVX2(__m256i lanes, RGB16::Channel* destination) {
+   _mm256_storeu_si256((__m256i*) destination, lanes);
+}
+
+/**
+ * @brief Blend rows of channels with AVX2, 16 channels at a time.
+ *
+ * @tparam Channel Type of a single channel, of #RGB8 or #RGB16.
+ * @param rows Input rows.
+ * @param weights Weights of the rows.
+ * @param count Number of rows.
+ * @param bias Start of the sums.
+ * @param channels Channels of the rows.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ * @return Number of channels blended, a multiple of 16.
+ */
+template <typename Channel>
+__attribute__((target("avx2")))
+size_t blendRowsAVX2(Channel const* const* rows, int const* weights,
+   int count, int bias, size_t channels, int colors, Channel* destination)
+{
+   __m256i maximum { _mm256_set1_epi16((short) colors) };
+   size_t index { 0 };
+
+   for (; index + 16 <= channels; index += 16) {
+      __m256i low { _mm256_set1_epi32(bias) };
+      __m256i high { low };
+
+      for (int row { 0 }; row < count; row++) {
+         __m256i weight { _mm256_set1_epi32(weights[row]) };
+
+         low = _mm256_add_epi32(low, _mm256_mullo_epi32(
+            widenAVX2(rows[row] + index), weight));
+         high = _mm256_add_epi32(high, _mm256_mullo_epi32(
+            widenAVX2(rows[row] + index + 8), weight));
+      }
+
+      /*
+       * The packing saturates the negative sums to zero.
+       */
+      __m256i lanes { _mm256_permute4x64_epi64(_mm256_packus_epi32(
+         _mm256_srai_epi32(low, RESAMPLE_BITS),
+         _mm256_srai_epi32(high, RESAMPLE_BITS)), 0xD8) };
+
+      storeAVX2(_mm256_min_epu16(lanes, maximum), destination + index);
+   }
+
+   return index;
+}
+
+/**
+ * @brief Add a weighted row of channels to accumulators with AVX2, 8
+ * channels at a time.
+ *
+ * @tparam Channel Type of a single channel, of #RGB8 or #RGB16.
+ * @param source First channel of the row.
+ * @param weight Weight of the row.
+ * @param first Whether the accumulators are set instead.
+ * @param channels Channels of the row.
+ * @param sums Accumulators of the channels.
+ * @return Number of channels accumulated, a multiple of 8.
+ */
+template <typename Channel>
+__attribute__((target("avx2")))
+size_t accumulateRowAVX2(Channel const* source, uint32_t weight, bool first,
+   size_t channels, uint32_t* sums)
+{
+   __m256i factor { _mm256_set1_epi32((int) weight) };
+   size_t index { 0 };
+
+   for (; index + 8 <= channels; index += 8) {
+      __m256i products { _mm256_mullo_epi32(widenAVX2(source + index),
+         factor) };
+
+      if (!first) {
+         products = _mm256_add_epi32(products,
+            _mm256_loadu_si256((__m256i const*) (sums + index)));
+      }
+
+      _mm256_storeu_si256((__m256i*) (sums + index), products);
+   }
+
+   return index;
+}
+#endif
+
+/**
+ * @brief Add a weighted row of channels to 32 bits accumulators.
+ *
+ * @tparam Channel Type of a single channel.
+ * @param source First channel of the row.
+ * @param weight Weight of the row.
+ * @param first Whether the accumulators are set instead.
+ * @param channels Channels of the row.
+ * @param sums Accumulators of the channels.
+ * @return Number of channels accumulated.
+ * @see accumulateRowAVX2()
+ */
+template <typename Channel>
+size_t accumulateVectors(Channel const* source, uint32_t weight, bool first,
+   size_t channels, uint32_t* sums)
+{
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      return accumulateRowAVX2(source, weight, first, channels, sums);
+   }
+#endif
+
+   return 0;
+}
+
+/**
+ * @brief Add a weighted row of channels to 64 bits accumulators.
+ *
+ * @tparam Channel Type of a single channel.
+ * @return Number of channels accumulated, none.
+ */
+template <typename Channel>
+size_t accumulateVectors(Channel const*, uint64_t, bool, size_t, uint64_t*) {
+   return 0;
+}
+
+/**
+ * @brief Add a weighted row of channels to accumulators.
+ *
+ * @tparam Channel Type of a single channel.
+ * @tparam Sum Type of the accumulators.
+ * @param source First channel of the row.
+ * @param weight Weight of the row.
+ * @param first Whether the accumulators are set instead.
+ * @param channels Channels of the row.
+ * @param sums Accumulators of the channels.
+ * @see accumulateVectors()
+ */
+template <typename Channel, typename Sum>
+void accumulateRow(Channel const* source, Sum weight, bool first,
+   size_t channels, Sum* sums)
+{
+   size_t index { accumulateVectors(source, weight, first, channels, sums) };
+
+   for (; index < channels; index++) {
+      sums[index] = (first ? 0 : sums[index]) + source[index] * weight;
+   }
+}
+
+/**
+ * @brief Resample a row of pixels across with a fixed number of taps.
+ *
+ * @tparam Count Neighbors of each position of the taps.
+ * @param source First channel of the input row.
+ * @param taps Taps of the columns.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ * @see resampleRowAVX2()
+ */
+template <int Count>
+void resampleRowVectors(RGB8::Channel const* source, Taps const& taps,
+   int colors, RGB8::Channel* destination)
+{
+   int column { 0 };
+
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      column = resampleRowAVX2<Count>(source, taps, colors, destination);
+   }
+#endif
+
+   resampleRowTaps<Count>(source, taps, column, colors, destination);
+}
+
+/**
+ * @brief Resample a row of pixels across with a fixed number of taps.
+ *
+ * @tparam Count Neighbors of each position of the taps.
+ * @param source First channel of the input row.
+ * @param taps Taps of the columns.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ */
+template <int Count>
+void resampleRowVectors(RGB16::Channel const* source, Taps const& taps,
+   int colors, RGB16::Channel* destination)
+{
+   resampleRowTaps<Count>(source, taps, 0, colors, destination);
+}
+
+/**
+ * @brief Resample a row of pixels across.
+ *
+ * @tparam Channel Type of a single channel.
+ * @param source First channel of the input row.
+ * @param taps Taps of the columns.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ * @see resampleRowVectors()
+ */
+template <typename Channel>
+void resampleRow(Channel const* source, Taps const& taps, int colors,
+   Channel* destination)
+{
+   if (taps.count == 1) {
+      resampleRowVectors<1>(source, taps, colors, destination);
+   } else if (taps.count == 2) {
+      resampleRowVectors<2>(source, taps, colors, destination);
+   } else {
+      resampleRowVectors<4>(source, taps, colors, destination);
+   }
+}
+
+/**
+ * @brief Blend rows of channels into a row of the output.
+ *
+ * @tparam Channel Type of a single channel.
+ * @param rows Input rows.
+ * @param weights Weights of the rows.
+ * @param count Number of rows.
+ * @param bias Start of the sums, the bias of the taps of the rows.
+ * @param channels Channels of the rows.
+ * @param colors Maximum of colors per pixel channel.
+ * @param destination First channel of the output row.
+ * @see blendRowsAVX2()
+ */
+template <typename Channel>
+void blendRows(Channel const* const* rows, int const* weights, int count,
+   int bias, size_t channels, int colors, Channel* destination)
+{
+   if (count == 1 && weights[0] == RESAMPLE_ONE) {
+      memcpy(destination, rows[0], channels * sizeof(Channel));
+      return;
+   }
+
+   size_t index { 0 };
+
+#if defined(KERNELS_X86)
+   if (hasAVX2()) {
+      index = blendRowsAVX2(rows, weights, count, bias, channels, colors,
+         destination);
+   }
+#endif
+
+   for (; index < channels; index++) {
+      int sum { bias };
+
+      for (int row { 0 }; row < count; row++) {
+         sum += rows[row][index] * weights[row];
+      }
+
+      destination[index] = (Channel) getResampledChannel(sum, colors);
+   }
+}
+
+#endif // RESAMPLING_HPP